@@ -0,0 +1,70 @@
+/**
+ * @file atlas.h
+ * @brief Empaquetador de texturas en atlas (paginas compartidas).
+ *
+ * Acomoda un conjunto de SDL_Surface en pocas texturas grandes usando un
+ * packer skyline bottom-left. Cada imagen se rodea de 'padding' pixeles
+ * que repiten su borde (extrusion), para que el filtrado o el redondeo de
+ * UVs no mezcle pixeles de la imagen vecina.
+ *
+ * Las imagenes se ordenan por altura antes de empaquetar; si una no entra
+ * en ninguna pagina abierta se crea otra. Una imagen mas grande que
+ * pageSize recibe una pagina propia de su tamanho. Cada pagina se recorta
+ * al area realmente ocupada antes de subirla a la GPU.
+ */
+
+#ifndef ATLAS_H
+#define ATLAS_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Lado maximo de una pagina del atlas (se limita al maximo del renderer). */
+#define ATLAS_PAGE_SIZE 2048
+
+/** @brief Pixeles de extrusion alrededor de cada imagen. */
+#define ATLAS_PADDING 2
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Formato de pixel de las paginas: el primer formato de 32 bits con
+ *        alpha que soporta el renderer (ARGB8888 si no informa ninguno).
+ *
+ * Las superficies que ya vienen en este formato se copian sin conversion.
+ * @return Formato SDL_PIXELFORMAT_*.
+ */
+Uint32 Atlas_PixelFormat(void);
+
+/**
+ * @brief Empaqueta las superficies en paginas y crea una textura por pagina.
+ * @param surfaces Superficies a empaquetar (no se modifican ni se liberan).
+ *                 Las entradas NULL se ignoran (pageOf = -1).
+ * @param count    Cantidad de superficies.
+ * @param pageSize Lado maximo de cada pagina en pixeles.
+ * @param padding  Pixeles de extrusion por lado.
+ * @param outPages Recibe el array de texturas (liberar con Atlas_FreePages).
+ * @param pageOf   Array de 'count' enteros: pagina asignada a cada superficie.
+ * @param rects    Array de 'count' rects: region de cada superficie dentro de
+ *                 su pagina (sin el padding).
+ * @return Cantidad de paginas creadas, 0 en caso de error.
+ */
+int Atlas_Build(SDL_Surface **surfaces, int count, int pageSize, int padding,
+                SDL_Texture ***outPages, int *pageOf, SDL_Rect *rects);
+
+/**
+ * @brief Destruye las texturas de las paginas y libera el array.
+ * @param pages     Array devuelto por Atlas_Build (puede ser NULL).
+ * @param pageCount Cantidad de paginas.
+ */
+void Atlas_FreePages(SDL_Texture **pages, int pageCount);
+
+#endif
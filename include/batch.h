@@ -0,0 +1,119 @@
+/**
+ * @file batch.h
+ * @brief Batching de sprites: agrupa quads por textura y los envia con
+ *        un solo SDL_RenderGeometry por textura + blend mode.
+ *
+ * Uso tipico por frame:
+ * @code
+ * SpriteBatch_Begin();
+ * SpriteBatch_Submit(&sprite);
+ * SpriteBatch_SubmitAnimated(&animado);
+ * SpriteBatch_Flush();
+ * @endcode
+ *
+ * Los sprites que comparten textura se dibujan en el orden en que se
+ * enviaron. Entre texturas distintas, el orden es el de la primera
+ * aparicion de cada textura en el batch.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "sprites.h"
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Contadores del ultimo batch enviado con SpriteBatch_Flush().
+ */
+typedef struct {
+    int sprites;    /**< @brief Sprites (o quads de SubmitQuads) encolados en el batch. */
+    int draw_calls; /**< @brief Llamadas a SDL_RenderGeometry emitidas. */
+} SpriteBatchStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Abre un batch nuevo. Los Submit posteriores se acumulan
+ *        hasta llamar a SpriteBatch_Flush().
+ */
+void SpriteBatch_Begin(void);
+
+/**
+ * @brief Encola un sprite (respeta flip y angle).
+ *
+ * El sprite se proyecta con la camara activa y se descarta si queda
+ * fuera de pantalla (ver camera.h). Si no hay un batch abierto, se
+ * dibuja de inmediato con Sprite_Draw().
+ *
+ * @param s Sprite a encolar.
+ */
+void SpriteBatch_Submit(const Sprite *s);
+
+/**
+ * @brief Encola el frame actual de un sprite animado.
+ * @param as Sprite animado a encolar.
+ */
+void SpriteBatch_SubmitAnimated(const AnimatedSprite *as);
+
+/**
+ * @brief Encola quads ya armados (4 vertices por quad: TL, TR, BR, BL).
+ *
+ * Los vertices se copian tal cual, con su color y UVs normalizadas.
+ * Si no hay un batch abierto se dibujan de inmediato con una sola
+ * llamada a SDL_RenderGeometry.
+ *
+ * @param texture   Textura de los quads.
+ * @param vertices  Array de 4 * quadCount vertices.
+ * @param quadCount Cantidad de quads.
+ */
+void SpriteBatch_SubmitQuads(SDL_Texture *texture, const SDL_Vertex *vertices, int quadCount);
+
+/**
+ * @brief Emite una llamada SDL_RenderGeometry por cada grupo
+ *        textura + blend mode y cierra el batch.
+ *
+ * No aplica el color/alpha mod de las texturas: los vertices de
+ * sprites se envian en blanco opaco.
+ */
+void SpriteBatch_Flush(void);
+
+/**
+ * @brief Arma los 4 vertices (TL, TR, BR, BL) de un sprite, con flip y rotacion.
+ * @param v     Destino (4 vertices).
+ * @param s     Sprite.
+ * @param inv_w 1 / ancho de la textura del sprite.
+ * @param inv_h 1 / alto de la textura del sprite.
+ */
+void SpriteBatch_BuildQuad(SDL_Vertex *v, const Sprite *s, float inv_w, float inv_h);
+
+/**
+ * @brief Buffer de indices compartido para dibujar quads con SDL_RenderGeometry.
+ * @param quads Quads que debe cubrir.
+ * @return Indices (6 por quad, relativos al primer vertice), o NULL sin memoria.
+ *         Valido hasta la siguiente llamada que lo haga crecer.
+ */
+const int *SpriteBatch_QuadIndices(int quads);
+
+/**
+ * @brief Devuelve los contadores del ultimo flush.
+ * @return Copia de los contadores.
+ */
+SpriteBatchStats SpriteBatch_GetStats(void);
+
+/**
+ * @brief Libera los buffers internos del batch. Llamar desde Game_Destroy().
+ */
+void SpriteBatch_Destroy(void);
+
+#endif
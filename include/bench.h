@@ -0,0 +1,74 @@
+/**
+ * @file bench.h
+ * @brief Escenas de benchmark del motor.
+ *
+ * Cada escena asume que Game_Init() ya se ejecuto (ventana, render y
+ * subsistemas activos) e imprime sus resultados por stdout.
+ * Se ejecutan con `make bench` (binario aparte compilado con BENCH_MAIN).
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+// ============================================================
+// Escenas
+// ============================================================
+
+/**
+ * @brief Compara dibujo inmediato (Sprite_Draw) contra SpriteBatch
+ *        con 1k, 10k y 50k sprites.
+ */
+void Bench_SpriteBatch(void);
+
+/**
+ * @brief Mide el escalado de Jobs_ParallelFor de 1 a N workers sobre
+ *        100k sprites animados y un kernel de calculo por elemento.
+ */
+void Bench_Jobs(void);
+
+/**
+ * @brief Compara rasterizar cada string con TTF contra el atlas de glyphs
+ *        (con y sin batch) con 500 textos de HUD que cambian cada frame.
+ */
+void Bench_Text(void);
+
+/**
+ * @brief Mide update (en paralelo) y dibujo de 10k, 50k y 100k entidades
+ *        que se mueven, rebotan y se animan.
+ */
+void Bench_Ecs(void);
+
+/**
+ * @brief Compara dibujo inmediato, SpriteBatch y RenderQueue con 1k, 10k
+ *        y 50k sprites que alternan entre varias texturas.
+ */
+void Bench_Queue(void);
+
+/**
+ * @brief Compara dibujar un mapa de tiles grande con scroll tile por tile
+ *        contra chunks horneados (estatico y con un tile editado por frame).
+ */
+void Bench_Tilemap(void);
+
+/**
+ * @brief Compara enviar todos los sprites de un nivel grande (la camara
+ *        descarta los de afuera) contra consultar la grilla espacial,
+ *        con 10k, 100k y 200k sprites.
+ */
+void Bench_Camera(void);
+
+/**
+ * @brief Compara redibujar todo el frame contra el modo dirty rects de la
+ *        cola de render con 1, 10 y 100 sprites en movimiento sobre una
+ *        escena estatica.
+ */
+void Bench_Dirty(void);
+
+/**
+ * @brief Mide el mezclador por software con 16, 64, 256 y 1024 voces en
+ *        cada kernel disponible (escalar, SSE2, AVX2): costo por voz por
+ *        milisegundo de audio y porcentaje de un nucleo.
+ */
+void Bench_Mixer(void);
+
+#endif
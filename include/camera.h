@@ -0,0 +1,94 @@
+/**
+ * @file camera.h
+ * @brief Camara 2D (posicion + zoom) y recorte de sprites fuera de pantalla.
+ *
+ * Los sprites se dibujan en coordenadas de mundo. Al enviarlos
+ * (Sprite_Draw, ASprite_Draw, SpriteBatch_Submit, RenderQueue_Sprite) se
+ * proyectan con la camara activa y los que quedan fuera de la pantalla
+ * logica (WIN_W x WIN_H) se descartan antes de llegar a SDL.
+ *
+ * Sin camara activa la proyeccion es la identidad (mundo = pantalla),
+ * pero el recorte contra la pantalla sigue aplicando. Lo que vive en
+ * coordenadas de pantalla (HUD, texto) se dibuja con la camara en NULL.
+ *
+ * @code
+ * Camera_SetActive(&camera);
+ * // ... mundo ...
+ * Camera_SetActive(NULL);
+ * // ... HUD ...
+ * @endcode
+ */
+
+#ifndef CAMERA_H
+#define CAMERA_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "sprites.h"
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Camara 2D: (x, y) es el punto del mundo en la esquina superior
+ *        izquierda de la pantalla; zoom > 1 acerca.
+ */
+typedef struct {
+    float x;    /**< @brief Borde izquierdo de la vista (mundo). */
+    float y;    /**< @brief Borde superior de la vista (mundo). */
+    float zoom; /**< @brief Pixeles de pantalla por unidad de mundo. */
+} Camera;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Camara identidad (origen en 0,0 y zoom 1).
+ */
+Camera Camera_Create(void);
+
+/**
+ * @brief Centra la camara en un punto del mundo (conserva el zoom).
+ */
+void Camera_CenterOn(Camera *cam, float worldX, float worldY);
+
+/**
+ * @brief Rectangulo del mundo que cubre la pantalla logica.
+ * @param cam Camara (NULL = camara activa).
+ */
+SDL_FRect Camera_View(const Camera *cam);
+
+/**
+ * @brief Convierte un punto de pantalla logica a coordenadas de mundo.
+ * @param cam Camara (NULL = camara activa).
+ */
+SDL_FPoint Camera_ScreenToWorld(const Camera *cam, float screenX, float screenY);
+
+/**
+ * @brief Fija la camara con la que se proyectan los sprites (se copia).
+ * @param cam Camara, o NULL para volver a la identidad.
+ */
+void Camera_SetActive(const Camera *cam);
+
+/**
+ * @brief Devuelve la camara activa.
+ */
+const Camera *Camera_GetActive(void);
+
+/**
+ * @brief Proyecta un sprite con la camara activa y lo recorta contra la pantalla.
+ *
+ * Los sprites rotados se prueban con su circulo envolvente.
+ * @param in  Sprite en coordenadas de mundo.
+ * @param out Sprite en coordenadas de pantalla (puede ser igual a 'in').
+ * @return false si el sprite queda completamente fuera de la pantalla.
+ */
+bool Camera_Project(const Sprite *in, Sprite *out);
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file compositor.h
+ * @brief Compositor de capas del frame con un target de render cacheado por capa.
+ *
+ * Game_Render se arma por capas con nombre, de atras hacia adelante:
+ * fondo, mundo, texto del HUD, overlay de debug y GUI. Una capa cacheada
+ * se dibuja sobre su propia textura de WIN_W x WIN_H y en los frames
+ * siguientes solo se vuelve a copiar al frame, hasta que alguien la
+ * marca sucia. Las capas que cambian todos los frames (mundo, debug) son
+ * directas: se dibujan sobre el frame sin textura intermedia, porque un
+ * target propio solo sumaria una copia de pantalla completa.
+ *
+ * El compositor no sabe que dibuja cada capa: quien la llena tiene que
+ * llamar Compositor_MarkDirty() ante cualquier cambio de su contenido,
+ * o la capa sigue mostrando la cache vieja. Game_Render marca el fondo
+ * cuando se mueve la camara o cuando Ecs_LayersChanged() lo indica; otro
+ * contenido (tiles re-horneados, sprites escritos directo en las columnas
+ * del mundo) necesita su propia llamada.
+ *
+ * Sin soporte de texturas de render (o con el cache apagado) todas las
+ * capas son directas y el compositor no cambia el resultado.
+ *
+ * Uso tipico por frame:
+ * @code
+ * if (Compositor_Begin(COMPOSITOR_HUD))   // false: se copio la cache
+ * {
+ *     Text_Draw(&puntaje, 10, 10);
+ *     Compositor_End();
+ * }
+ * @endcode
+ */
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Capas del frame, en orden de composicion.
+ */
+typedef enum {
+    COMPOSITOR_BACKGROUND, /**< @brief Fondo y mapas (cacheada, sucia al mover la camara). */
+    COMPOSITOR_WORLD,      /**< @brief Personajes y objetos (directa). */
+    COMPOSITOR_HUD,        /**< @brief Texto del HUD (cacheada). */
+    COMPOSITOR_DEBUG,      /**< @brief Overlay de herramientas de debug (directa). */
+    COMPOSITOR_GUI,        /**< @brief Ventanas de Nuklear (cacheada). */
+    COMPOSITOR_LAYER_COUNT
+} CompositorLayer;
+
+/**
+ * @brief Contadores del ultimo frame.
+ */
+typedef struct {
+    int redrawn;    /**< @brief Capas cacheadas que se redibujaron. */
+    int reused;     /**< @brief Capas cacheadas que solo se copiaron. */
+    int direct;     /**< @brief Capas dibujadas directo sobre el frame. */
+} CompositorStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Crea los targets de las capas cacheadas (tamano WIN_W x WIN_H).
+ * @param enabled false para dibujar todas las capas directo.
+ * @return false si el cache quedo apagado (sin soporte o sin memoria).
+ */
+bool Compositor_Init(bool enabled);
+
+/**
+ * @brief Libera los targets de las capas.
+ */
+void Compositor_Destroy(void);
+
+/**
+ * @brief Marca una capa para redibujarla en su proximo Compositor_Begin().
+ */
+void Compositor_MarkDirty(CompositorLayer layer);
+
+/**
+ * @brief Marca todas las capas sucias (ej: tras SDL_RENDER_TARGETS_RESET).
+ */
+void Compositor_Invalidate(void);
+
+/**
+ * @brief Muestra u oculta una capa. Una capa oculta no se dibuja ni se compone.
+ */
+void Compositor_SetVisible(CompositorLayer layer, bool visible);
+
+/**
+ * @brief Empieza una capa.
+ *
+ * Si la capa esta cacheada y limpia, copia su textura al frame y
+ * devuelve false (no hay que dibujar nada). Si hay que dibujarla, deja
+ * activo su target (vacio y transparente) o el frame si es directa.
+ * @param layer Capa a dibujar (en orden de CompositorLayer).
+ * @return true si el caller tiene que dibujar la capa y llamar a Compositor_End().
+ */
+bool Compositor_Begin(CompositorLayer layer);
+
+/**
+ * @brief Termina la capa abierta: restaura el target del frame y la compone.
+ */
+void Compositor_End(void);
+
+/**
+ * @brief Devuelve los contadores del ultimo frame completo.
+ */
+CompositorStats Compositor_GetStats(void);
+
+#endif
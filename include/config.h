@@ -48,6 +48,9 @@
 /** @brief Directorio de logs. */
 #define LOGS_DIR "logs/"
 
+/** @brief Directorio de datos regenerables (atlas de fuentes horneados). */
+#define CACHE_DIR "cache/"
+
 // ============================================================
 // Archivos de configuracion
 // ============================================================
@@ -80,14 +83,23 @@ typedef struct {
     bool vsync;          /**< @brief Activar sincronizacion vertical. */
     int fps;             /**< @brief Frames por segundo objetivo. */
     int defaultMonitor;  /**< @brief Indice del monitor por defecto. */
+    bool render_target;  /**< @brief Dibujar a WIN_W x WIN_H y escalar por un entero al presentar. */
+    bool dirty_rects;    /**< @brief Redibujar solo las regiones que cambiaron (renderer por software). */
+    bool layer_cache;    /**< @brief Cachear fondo, HUD y GUI en texturas y recomponer solo lo que cambio. */
 
     int master_volume;   /**< @brief Volumen maestro (0-100). */
     int music_volume;    /**< @brief Volumen de la musica (0-100). */
     int sfx_volume;      /**< @brief Volumen de efectos de sonido (0-100). */
     int audio_frequency; /**< @brief Frecuencia de audio en Hz. */
+    int mixer_voices;    /**< @brief Voces del mezclador por software (0 = canales de SDL_mixer). */
 
     bool show_fps;       /**< @brief Mostrar contador de FPS en pantalla. */
+    int tick_rate;       /**< @brief Ticks de simulacion por segundo (paso fijo). */
+    int max_ticks;       /**< @brief Maximo de ticks por frame antes de descartar atraso. */
+    int gui_arena_kb;    /**< @brief Arena de memoria de Nuklear en KB (0 = heap). */
+
     bool debug_mode;     /**< @brief Activar modo de depuracion. */
+    int headless_frames; /**< @brief Frames a ejecutar sin ventana antes de salir (0 = modo normal). */
 } GameConfig;
 
 // ============================================================
@@ -0,0 +1,213 @@
+/**
+ * @file ecs.h
+ * @brief Almacen de entidades con componentes en estructura de arrays (SoA).
+ *
+ * Cada mundo guarda sus entidades vivas empaquetadas en [0, count): la
+ * columna de cada componente es un array plano indexado por ese slot
+ * denso (x[], y[], vx[], ...). Al destruir una entidad, la ultima ocupa
+ * su lugar, asi que los arrays nunca tienen huecos. Los componentes
+ * opcionales se marcan con bits en mask[].
+ *
+ * Los ids (Entity) llevan indice + generacion: un id de una entidad ya
+ * destruida deja de ser valido aunque su indice se reutilice.
+ *
+ * Los sistemas recorren rangos de slots y pueden repartirse entre los
+ * workers con Ecs_Run(). Mientras corre un sistema no se pueden crear ni
+ * destruir entidades.
+ */
+
+#ifndef ECS_H
+#define ECS_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "img.h"
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Bits del id usados por el indice (el resto es la generacion). */
+#define ECS_INDEX_BITS 20
+
+/** @brief Maximo de entidades por mundo. */
+#define ECS_MAX_ENTITIES (1 << ECS_INDEX_BITS)
+
+/** @brief Id nulo (ninguna entidad tiene generacion 0). */
+#define ECS_NULL 0u
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/** @brief Id de entidad: generacion (bits altos) + indice (bits bajos). */
+typedef Uint32 Entity;
+
+/**
+ * @brief Componentes opcionales (la posicion la tienen todas las entidades).
+ */
+typedef enum {
+    ECS_VELOCITY = 1 << 0, /**< @brief vx, vy (pixeles por segundo). */
+    ECS_SPRITE   = 1 << 1, /**< @brief texture, src, w, h. */
+    ECS_ANIM     = 1 << 2  /**< @brief clip, anim_start (animacion por tiempo). */
+} EcsComponent;
+
+/**
+ * @brief Mundo de entidades. Las columnas son de lectura/escritura directa
+ *        para los sistemas; el resto se maneja con las funciones Ecs_*.
+ */
+typedef struct {
+    int count;              /**< @brief Entidades vivas (slots [0, count)). */
+    int capacity;           /**< @brief Maximo de entidades de este mundo. */
+
+    // Columnas densas (indice = slot)
+    Entity *entity;         /**< @brief Id de la entidad de cada slot. */
+    Uint8 *mask;            /**< @brief Bits EcsComponent presentes. */
+    float *x, *y;           /**< @brief Posicion actual. */
+    float *prev_x, *prev_y; /**< @brief Posicion al inicio del tick (para interpolar). */
+    float *vx, *vy;         /**< @brief ECS_VELOCITY. */
+    SDL_Texture **texture;  /**< @brief ECS_SPRITE: pagina de atlas. */
+    SDL_Rect *src;          /**< @brief ECS_SPRITE: region (frame 0 si tiene ECS_ANIM). */
+    float *w, *h;           /**< @brief ECS_SPRITE: tamanho en pantalla. */
+    int *clip;              /**< @brief ECS_ANIM: id de AnimationClip. */
+    double *anim_start;     /**< @brief ECS_ANIM: instante de inicio del clip. */
+    Uint8 *layer;           /**< @brief Capa de render (RENDER_LAYER_*), 0 por defecto. */
+    Uint32 dirty_layers[8]; /**< @brief Bit por capa cuyo contenido cambio (ver Ecs_LayersChanged()). */
+
+    // Indices dispersos (indice del id -> slot)
+    int *sparse;            /**< @brief Slot de cada indice, -1 si esta libre. */
+    Uint16 *generation;     /**< @brief Generacion actual de cada indice. */
+    int *free_list;         /**< @brief Pila de indices libres. */
+    int free_count;         /**< @brief Indices en la pila. */
+} EcsWorld;
+
+/**
+ * @brief Sistema: procesa los slots [start, end) de un mundo.
+ */
+typedef void (*EcsSystemFn)(EcsWorld *w, int start, int end, void *data);
+
+// ============================================================
+// Mundo
+// ============================================================
+
+/**
+ * @brief Reserva todas las columnas de un mundo (no crece despues).
+ * @param w        Mundo a inicializar.
+ * @param capacity Maximo de entidades (hasta ECS_MAX_ENTITIES).
+ * @return true si se pudo reservar la memoria.
+ */
+bool Ecs_Init(EcsWorld *w, int capacity);
+
+/**
+ * @brief Libera las columnas del mundo. Los ids dejan de ser validos.
+ * @param w Mundo.
+ */
+void Ecs_Free(EcsWorld *w);
+
+// ============================================================
+// Entidades y componentes
+// ============================================================
+
+/**
+ * @brief Crea una entidad con posicion.
+ * @return Id de la entidad, o ECS_NULL si el mundo esta lleno.
+ */
+Entity Ecs_Create(EcsWorld *w, float x, float y);
+
+/**
+ * @brief Destruye una entidad (la ultima del array ocupa su slot).
+ */
+void Ecs_Destroy(EcsWorld *w, Entity e);
+
+/**
+ * @brief Indica si el id corresponde a una entidad viva.
+ */
+bool Ecs_Alive(const EcsWorld *w, Entity e);
+
+/**
+ * @brief Slot denso de una entidad (cambia cuando se destruyen otras).
+ * @return Slot, o -1 si el id no es valido.
+ */
+int Ecs_Slot(const EcsWorld *w, Entity e);
+
+/** @brief Mueve la entidad sin interpolar desde la posicion anterior. */
+void Ecs_SetPosition(EcsWorld *w, Entity e, float x, float y);
+
+/** @brief Agrega o actualiza ECS_VELOCITY. */
+void Ecs_SetVelocity(EcsWorld *w, Entity e, float vx, float vy);
+
+/**
+ * @brief Agrega o actualiza ECS_SPRITE con una region de atlas (tamanho = region).
+ *
+ * Si la entidad ya tiene ECS_ANIM solo se toma la textura: la region y el
+ * tamanho siguen siendo los del clip.
+ */
+void Ecs_SetSprite(EcsWorld *w, Entity e, TextureRegion region);
+
+/**
+ * @brief Agrega o actualiza ECS_ANIM: reproduce un clip por tiempo desde 'start'.
+ *
+ * El tamanho del sprite pasa a ser el del primer frame del clip, se llame
+ * antes o despues de Ecs_SetSprite(). Para volver a una region fija,
+ * Ecs_Remove(ECS_ANIM) y despues Ecs_SetSprite().
+ */
+void Ecs_SetAnim(EcsWorld *w, Entity e, int clip, double start);
+
+/** @brief Cambia la capa de render de la entidad (ver renderqueue.h). */
+void Ecs_SetLayer(EcsWorld *w, Entity e, Uint8 layer);
+
+/** @brief Quita componentes opcionales (bits EcsComponent). */
+void Ecs_Remove(EcsWorld *w, Entity e, Uint8 components);
+
+/**
+ * @brief Indica si cambio lo que dibujan las capas [first, last] desde la llamada anterior.
+ *
+ * Cuenta los cambios hechos con las funciones Ecs_* (sprite, animacion,
+ * capa, posicion, velocidad, destruccion) y las entidades que se movieron
+ * en el ultimo tick o tienen ECS_ANIM. Escribir directo en texture[],
+ * src[], w[], h[] o layer[] no se detecta. Limpia las marcas del rango:
+ * pensado para decidir si una capa cacheada del compositor esta sucia.
+ */
+bool Ecs_LayersChanged(EcsWorld *w, Uint8 first, Uint8 last);
+
+// ============================================================
+// Sistemas
+// ============================================================
+
+/**
+ * @brief Ejecuta un sistema sobre todas las entidades, repartido entre workers.
+ * @param w        Mundo.
+ * @param fn       Sistema (los rangos no se solapan).
+ * @param data     Datos del sistema.
+ * @param minBatch Minimo de slots por rango.
+ */
+void Ecs_Run(EcsWorld *w, EcsSystemFn fn, void *data, int minBatch);
+
+/**
+ * @brief Guarda la posicion previa y aplica la velocidad (en paralelo).
+ * @param w  Mundo.
+ * @param dt Duracion del tick (segundos).
+ */
+void Ecs_Move(EcsWorld *w, float dt);
+
+/**
+ * @brief Encola todas las entidades con sprite en la cola de render, en su capa.
+ *
+ * Sin una cola abierta se envian al SpriteBatch (o se dibujan). La posicion se interpola con 'alpha' y el frame de ECS_ANIM se evalua
+ * en 'now'. Corre en el hilo principal.
+ */
+void Ecs_Draw(const EcsWorld *w, float alpha, double now);
+
+/**
+ * @brief Igual que Ecs_Draw() pero solo las entidades con capa en [first, last].
+ *
+ * Permite repartir las capas de la cola entre capas del compositor
+ * (ej: el fondo en una textura cacheada y el mundo directo).
+ */
+void Ecs_DrawLayers(const EcsWorld *w, float alpha, double now, Uint8 first, Uint8 last);
+
+#endif
@@ -17,7 +17,11 @@
 
 extern bool INSTANCE;              /**< @brief Controla el game loop. false = salir. */
 extern int last_frame;             /**< @brief Timestamp del ultimo frame (en ms). */
-extern float deltatime;            /**< @brief Tiempo entre frames (en segundos). */
+extern float deltatime;            /**< @brief Tiempo real entre frames (en segundos). */
+extern float fixed_deltatime;      /**< @brief Duracion de un tick de simulacion (en segundos). */
+extern float render_alpha;         /**< @brief Fraccion (0-1) del siguiente tick ya transcurrida. Para interpolar el render. */
+extern double sim_time;            /**< @brief Tiempo de simulacion acumulado (en segundos, avanza por ticks). */
+extern int dropped_ticks;          /**< @brief Ticks descartados por atraso (mas de max_ticks en un frame) desde el inicio. */
 extern SDL_Renderer *render;       /**< @brief Renderer principal de SDL. */
 extern SDL_Window *window;         /**< @brief Ventana principal de SDL. */
 extern SDL_Color renderColor;      /**< @brief Color de fondo del render. */
@@ -31,6 +35,16 @@ extern TTF_Font *font;             /**< @brief Fuente global (legacy). */
 // Ciclo de vida del juego
 // ============================================================
 
+/**
+ * @brief Fuerza el modo headless (llamar antes de Game_Init).
+ *
+ * En modo headless se usan los drivers dummy de video y audio, un
+ * renderer por software que dibuja sobre una textura fuera de pantalla
+ * y pacing sin limite. Tiene prioridad sobre headless_frames del .ini.
+ * @param frames Frames a ejecutar antes de salir (0 = usar el .ini).
+ */
+void Game_SetHeadless(int frames);
+
 /**
  * @brief Inicializa todos los subsistemas: SDL, ventana, render, audio, texto, GUI.
  * @return true si todo se inicializo correctamente, false en caso de error.
@@ -48,7 +62,11 @@ void Game_Setup();
 void Game_KeyboardInput();
 
 /**
- * @brief Calcula deltatime y controla el framerate.
+ * @brief Calcula deltatime, ejecuta 0..N ticks de simulacion de paso fijo
+ *        y controla el framerate.
+ *
+ * El numero de ticks por frame esta limitado por config.max_ticks; si el
+ * atraso supera ese limite, se descarta (evita el "spiral of death").
  */
 void Game_UpdateFrame();
 
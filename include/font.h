@@ -0,0 +1,131 @@
+/**
+ * @file font.h
+ * @brief Servicio de fuentes compartido: una sola carga por (ruta, tamanho).
+ *
+ * Text, la GUI de Nuklear y la herramienta Font Debug piden sus fuentes
+ * aca. Cada combinacion (ruta, tamanho) se abre con SDL_ttf y se
+ * rasteriza una sola vez por proceso: sus glyphs Latin-1 quedan en un
+ * atlas de paginas (atlas.h) que comparten todos los que usan el handle.
+ * Los handles llevan un contador de referencias; la fuente se cierra y su
+ * atlas se libera cuando se suelta la ultima.
+ *
+ * Las superficies de los glyphs se guardan en la cache de disco
+ * (fontcache.h), asi que en los arranques siguientes ni siquiera se
+ * rasterizan: solo se empaquetan y se suben.
+ *
+ * @code
+ * Font *f = Font_Acquire(FONTS_DIR JERSEY_FONT, 24);
+ * Uint32 cp = 'A';
+ * const FontGlyph *g = Font_Glyph(f, &cp);
+ * ...
+ * Font_Release(f);
+ * @endcode
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <stdbool.h>
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Primer codepoint rasterizado (espacio). */
+#define FONT_FIRST_GLYPH 32
+
+/** @brief Ultimo codepoint rasterizado (fin de Latin-1). */
+#define FONT_LAST_GLYPH 255
+
+/** @brief Glyphs por fuente. */
+#define FONT_GLYPHS (FONT_LAST_GLYPH - FONT_FIRST_GLYPH + 1)
+
+/** @brief Reemplazo de los codepoints que la fuente no tiene. */
+#define FONT_FALLBACK '?'
+
+/** @brief Maximo de paginas de atlas por fuente (fuentes mas grandes no se cargan). */
+#define FONT_MAX_PAGES 4
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Glyph rasterizado: region en el atlas y metricas de avance.
+ */
+typedef struct {
+    SDL_Rect src;         /**< @brief Region en la pagina (w, h = tamanho de la superficie rasterizada). */
+    int page;             /**< @brief Pagina del atlas, -1 si no tiene imagen (espacio o glyph ausente). */
+    int offset_x;         /**< @brief Desplazamiento horizontal del quad respecto del cursor. */
+    int advance;          /**< @brief Avance del cursor (0 = la fuente no tiene el glyph). */
+    float u0, v0, u1, v1; /**< @brief UVs normalizadas en la pagina. */
+} FontGlyph;
+
+/**
+ * @brief Fuente cargada: TTF de tamanho fijo mas su atlas de glyphs.
+ *
+ * Los campos son de solo lectura para los usuarios del servicio.
+ */
+typedef struct {
+    char *path;                   /**< @brief Ruta de la TTF. */
+    int size;                     /**< @brief Tamanho en puntos. */
+    int refs;                     /**< @brief Referencias (Font_Acquire - Font_Release). */
+    TTF_Font *ttf;                /**< @brief Fuente de SDL_ttf (kerning y metricas). */
+    SDL_Texture **pages;          /**< @brief Paginas del atlas. */
+    int page_count;               /**< @brief Paginas en uso (0 = sin atlas). */
+    int height;                   /**< @brief Alto de una linea (TTF_FontHeight). */
+    int line_skip;                /**< @brief Distancia entre lineas (TTF_FontLineSkip). */
+    bool kerning;                 /**< @brief La fuente tiene kerning activo. */
+    FontGlyph glyphs[FONT_GLYPHS];/**< @brief Glyphs desde FONT_FIRST_GLYPH. */
+    FontGlyph white;              /**< @brief Bloque blanco opaco en el atlas (geometria sin textura). */
+} Font;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Devuelve la fuente (ruta, tamanho), abriendola y rasterizandola
+ *        solo si nadie la tiene cargada. Suma una referencia.
+ *
+ * Necesita TTF_Init() y el renderer global (para subir el atlas).
+ * @return Handle compartido, o NULL si no se pudo abrir la TTF o crear el atlas.
+ */
+Font *Font_Acquire(const char *path, int size);
+
+/**
+ * @brief Suelta una referencia; con la ultima se cierra la fuente y se
+ *        libera su atlas. Acepta NULL.
+ */
+void Font_Release(Font *font);
+
+/**
+ * @brief Glyph de un codepoint; si la fuente no lo tiene, 'cp' pasa a ser
+ *        FONT_FALLBACK y se devuelve ese.
+ */
+const FontGlyph *Font_Glyph(const Font *font, Uint32 *cp);
+
+/**
+ * @brief Ajuste de kerning entre dos codepoints (0 si la fuente no tiene kerning).
+ */
+int Font_Kerning(const Font *font, Uint32 prev, Uint32 cp);
+
+/**
+ * @brief Cantidad de fuentes cargadas en este momento.
+ */
+int Font_Count(void);
+
+/**
+ * @brief Cierra las fuentes que quedaron abiertas y llama a TTF_Quit().
+ *
+ * Va despues de soltar todas las fuentes (Text, GUI, debug) y antes de
+ * destruir el renderer.
+ */
+void Font_QuitSystem(void);
+
+#endif
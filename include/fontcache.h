@@ -0,0 +1,71 @@
+/**
+ * @file fontcache.h
+ * @brief Cache en disco de atlas de fuentes ya rasterizados.
+ *
+ * Rasterizar una fuente es de lo mas caro del arranque. El servicio de
+ * fuentes (font.h) guarda el resultado en CACHE_DIR y en los arranques
+ * siguientes lo carga tal cual, sin rasterizar la TTF.
+ *
+ * Cada archivo lleva una clave: el hash de los bytes de la TTF, el
+ * tamanho y los parametros de horneado (rangos de glyphs, formato de los
+ * datos). Si algo cambia, la clave no coincide y se vuelve a hornear.
+ * El contenido (payload) lo define cada usuario de la cache.
+ *
+ * @code
+ * Uint64 key = FontCache_Key(path, 30.0f, &params, sizeof(params));
+ * size_t size;
+ * void *data = FontCache_Load("font_Jersey10-Regular_30", key, &size);
+ * if (!data) { ...hornear...; FontCache_Save("font_Jersey10-Regular_30", key, blob, blobSize); }
+ * @endcode
+ */
+
+#ifndef FONTCACHE_H
+#define FONTCACHE_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Firma de los archivos de cache ("FNTC"). */
+#define FONTCACHE_MAGIC 0x43544E46u
+
+/** @brief Version del formato del header. */
+#define FONTCACHE_VERSION 1
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Calcula la clave de una fuente horneada.
+ * @param fontPath   Ruta de la TTF (se hashean sus bytes).
+ * @param size       Tamanho de la fuente.
+ * @param params     Parametros de horneado que cambian el resultado (puede ser NULL).
+ * @param paramsSize Bytes de 'params'.
+ * @return Clave, o 0 si no se pudo leer la TTF (no usar la cache).
+ */
+Uint64 FontCache_Key(const char *fontPath, float size, const void *params, size_t paramsSize);
+
+/**
+ * @brief Lee el payload guardado con 'name' si su clave coincide.
+ * @param name Nombre del archivo dentro de CACHE_DIR (sin extension).
+ * @param key  Clave esperada (FontCache_Key).
+ * @param size Recibe el tamanho del payload.
+ * @return Payload (liberar con free), o NULL si no hay cache valida.
+ */
+void *FontCache_Load(const char *name, Uint64 key, size_t *size);
+
+/**
+ * @brief Guarda (o reemplaza) el payload de 'name' con su clave.
+ * @return false si no se pudo escribir (la cache es opcional, no es un error fatal).
+ */
+bool FontCache_Save(const char *name, Uint64 key, const void *data, size_t size);
+
+#endif
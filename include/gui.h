@@ -32,6 +32,25 @@
 // ============================================================
 struct nk_context;
 
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Uso de la arena de memoria de Nuklear.
+ *
+ * El pico incluye las copias viejas de los buffers que crecieron (el
+ * bump allocator no las recupera), asi que es la medida para dimensionar
+ * [GUI] arena_kb.
+ */
+typedef struct {
+    size_t size;           /**< @brief Tamano de la arena (0 = heap). */
+    size_t used;           /**< @brief Bytes en uso. */
+    size_t peak;           /**< @brief Maximo de bytes en uso desde el init. */
+    int overflow_allocs;   /**< @brief Reservas que no entraron y fueron a malloc. */
+    size_t overflow_bytes; /**< @brief Bytes reservados con malloc por arena llena. */
+} GuiArenaStats;
+
 // ============================================================
 // Funciones publicas
 // ============================================================
@@ -39,16 +58,17 @@ struct nk_context;
 /**
  * @brief Inicializa el subsistema GUI (Nuklear + SDL2 renderer).
  *
- * Crea el contexto Nuklear, carga la fuente indicada y la establece
- * como fuente por defecto.
+ * Crea el contexto Nuklear sobre una arena de tamano fijo, carga la
+ * fuente indicada y la establece como fuente por defecto.
  *
  * @param win       Ventana SDL sobre la que se dibujara la GUI.
  * @param ren       Renderer SDL asociado a la ventana.
  * @param font_path Ruta al archivo de fuente TTF (puede ser NULL para fuente por defecto).
  * @param font_size Tamano en puntos de la fuente.
+ * @param arena_kb  Tamano de la arena de Nuklear en KB (0 = malloc/free de Nuklear).
  * @return true si la inicializacion fue exitosa, false en caso contrario.
  */
-bool GUI_Init(SDL_Window *win, SDL_Renderer *ren, const char *font_path, float font_size);
+bool GUI_Init(SDL_Window *win, SDL_Renderer *ren, const char *font_path, float font_size, int arena_kb);
 
 /**
  * @brief Pasa un evento SDL al sistema de entrada de Nuklear.
@@ -70,14 +90,42 @@ void GUI_InputEnd(void);
 
 /**
  * @brief Renderiza todos los comandos de dibujo acumulados por Nuklear.
+ *
+ * Los buffers de vertices e indices se conservan entre frames. Si los
+ * comandos son iguales a los del frame anterior no se llama a nk_convert
+ * y se redibuja la geometria guardada; los comandos consecutivos con la
+ * misma textura y clip van en un solo SDL_RenderGeometryRaw.
  */
 void GUI_Render(void);
 
+/**
+ * @brief Indica si los comandos de este frame difieren de los del ultimo GUI_Render().
+ *
+ * Se llama despues de armar las ventanas y antes de renderizar o
+ * descartar. Permite reusar la capa de GUI cacheada (ver compositor.h).
+ */
+bool GUI_Changed(void);
+
+/**
+ * @brief Indica si ninguna ventana tiene algo para dibujar este frame.
+ */
+bool GUI_IsEmpty(void);
+
+/**
+ * @brief Cierra el frame de Nuklear sin dibujar (en lugar de GUI_Render()).
+ */
+void GUI_Discard(void);
+
 /**
  * @brief Libera todos los recursos del subsistema GUI.
  */
 void GUI_Destroy(void);
 
+/**
+ * @brief Devuelve el uso de la arena de Nuklear (para el overlay de debug).
+ */
+GuiArenaStats GUI_GetArenaStats(void);
+
 /**
  * @brief Obtiene el contexto Nuklear activo.
  *
@@ -14,13 +14,29 @@
 
 /**
  * @brief Libreria de texturas cargadas desde un directorio.
+ *
+ * Las imagenes se empaquetan en pocas paginas de atlas: textures_array[i]
+ * es la pagina que contiene la imagen i (varias imagenes comparten la
+ * misma textura) y rects[i] su region dentro de la pagina. Usar siempre
+ * rects[i] (o getTextureRegion) como src al dibujar.
  */
 typedef struct texture_{
-    SDL_Texture **textures_array;  /**< @brief Array de texturas SDL. */
-    SDL_Rect **rects;              /**< @brief Array de rectangulos (tamano de cada textura). */
+    SDL_Texture **textures_array;  /**< @brief Pagina del atlas de cada imagen (compartidas, no destruir). */
+    SDL_Rect **rects;              /**< @brief Region de cada imagen dentro de su pagina. */
+    char **names;                  /**< @brief Nombre de archivo de cada imagen. */
+    SDL_Texture **pages;           /**< @brief Paginas del atlas (duenhas de las texturas). */
+    int page_count;                /**< @brief Cantidad de paginas. */
     int n;                         /**< @brief Cantidad de texturas cargadas. */
 }texture;
 
+/**
+ * @brief Region de una textura: lo necesario para dibujar una imagen del atlas.
+ */
+typedef struct {
+    SDL_Texture *texture;  /**< @brief Pagina que contiene la imagen. */
+    SDL_Rect src;          /**< @brief Region de la imagen dentro de la pagina. */
+}TextureRegion;
+
 // ============================================================
 // Inicializacion y cierre
 // ============================================================
@@ -41,12 +57,28 @@ void quitTexture(void);
 // ============================================================
 
 /**
- * @brief Carga todas las imagenes de un directorio en una libreria de texturas.
+ * @brief Carga todas las imagenes de un directorio y las empaqueta en paginas de atlas.
  * @param path Ruta del directorio con las imagenes.
  * @return texture Libreria cargada (n=0 si fallo).
  */
 texture initTextureLib(char *path);
 
+/**
+ * @brief Busca una imagen de la libreria por nombre de archivo.
+ * @param txr Libreria de texturas.
+ * @param name Nombre del archivo (sin directorio).
+ * @return Indice de la imagen, o -1 si no existe.
+ */
+int findTexture(const texture *txr, const char *name);
+
+/**
+ * @brief Devuelve la region (pagina + sub-rect) de una imagen de la libreria.
+ * @param txr Libreria de texturas.
+ * @param index Indice de la imagen.
+ * @return Region de la imagen (texture NULL si el indice no es valido).
+ */
+TextureRegion getTextureRegion(const texture *txr, int index);
+
 /**
  * @brief Libera todos los recursos de una libreria de texturas.
  * @param txr Puntero a la libreria a liberar.
@@ -0,0 +1,110 @@
+/**
+ * @file jobs.h
+ * @brief Sistema de jobs con work-stealing sobre hilos SDL.
+ *
+ * Hay un worker por nucleo: el hilo principal es el worker 0 y se crean
+ * N-1 hilos adicionales. Cada worker tiene su propia cola doble: el
+ * dueno apila y desapila por el final (LIFO, cache caliente) y los
+ * demas roban por el principio (FIFO) cuando se quedan sin trabajo.
+ *
+ * La sincronizacion se hace con JobCounter: cada job encolado con un
+ * contador lo incrementa y lo decrementa al terminar. Jobs_Wait() espera
+ * a que llegue a cero ejecutando jobs pendientes mientras tanto, por lo
+ * que es seguro llamarlo desde dentro de otro job.
+ *
+ * Si el sistema no esta iniciado o solo hay un nucleo, los jobs se
+ * ejecutan en linea dentro de Jobs_Run().
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Contador de jobs pendientes. Inicializar con {0}.
+ */
+typedef struct {
+    SDL_atomic_t pending; /**< @brief Jobs encolados con este contador que aun no terminan. */
+} JobCounter;
+
+/** @brief Funcion de un job. */
+typedef void (*JobFunc)(void *data);
+
+/** @brief Funcion de un rango de Jobs_ParallelFor: procesa [start, end). */
+typedef void (*JobRangeFunc)(int start, int end, void *data);
+
+// ============================================================
+// Inicializacion y cierre
+// ============================================================
+
+/**
+ * @brief Crea los hilos worker.
+ * @param workers Total de workers incluyendo el hilo principal.
+ *                0 = uno por nucleo (SDL_GetCPUCount()).
+ * @return true si se inicio correctamente, false en caso de error.
+ */
+bool Jobs_Init(int workers);
+
+/**
+ * @brief Detiene y espera a todos los workers. Los jobs aun encolados
+ *        se ejecutan antes de salir.
+ */
+void Jobs_Quit(void);
+
+/**
+ * @brief Cantidad de workers activos (incluye el hilo principal).
+ * @return Numero de workers, 1 si el sistema no esta iniciado.
+ */
+int Jobs_WorkerCount(void);
+
+// ============================================================
+// Encolado y espera
+// ============================================================
+
+/**
+ * @brief Encola un job.
+ * @param fn      Funcion a ejecutar.
+ * @param data    Argumento para la funcion (debe vivir hasta que termine).
+ * @param counter Contador a incrementar (puede ser NULL).
+ */
+void Jobs_Run(JobFunc fn, void *data, JobCounter *counter);
+
+/**
+ * @brief Encola un job que no empieza hasta que 'dependency' llegue a cero.
+ *
+ * Los jobs de los que depende deben estar encolados antes de llamar:
+ * si el contador ya esta en cero, el job puede ejecutarse de inmediato.
+ * @param dependency Contador del que depende (NULL = sin dependencia).
+ * @param fn         Funcion a ejecutar.
+ * @param data       Argumento para la funcion.
+ * @param counter    Contador a incrementar (puede ser NULL).
+ */
+void Jobs_RunAfter(JobCounter *dependency, JobFunc fn, void *data, JobCounter *counter);
+
+/**
+ * @brief Espera a que el contador llegue a cero, ejecutando jobs
+ *        pendientes mientras tanto.
+ * @param counter Contador a esperar.
+ */
+void Jobs_Wait(JobCounter *counter);
+
+/**
+ * @brief Reparte [0, count) en rangos entre los workers y espera a que
+ *        terminen todos. El hilo que llama tambien procesa un rango.
+ * @param count    Cantidad de elementos.
+ * @param minBatch Tamanho minimo de cada rango (evita jobs demasiado chicos).
+ * @param fn       Funcion que procesa un rango.
+ * @param data     Argumento compartido por todos los rangos.
+ */
+void Jobs_ParallelFor(int count, int minBatch, JobRangeFunc fn, void *data);
+
+#endif
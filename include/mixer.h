@@ -0,0 +1,151 @@
+/**
+ * @file mixer.h
+ * @brief Mezclador de efectos por software con kernels SIMD y cola de
+ *        comandos sin locks.
+ *
+ * Backend opcional de sound.c ([Audio] mixer_voices > 0). Mezcla una
+ * cantidad configurable de voces, sin el limite de canales de SDL_mixer
+ * ni su lock por canal: el hilo del juego solo escribe comandos (play,
+ * stop, ganancia) en una cola circular de un productor y un consumidor,
+ * y el hilo de audio los aplica al empezar cada buffer.
+ *
+ * La mezcla corre en el callback de audio de SDL_mixer como post-mix
+ * (Mix_SetPostMix), sobre la salida de la musica: asi la musica y la
+ * carga y conversion de chunks siguen en SDL_mixer. Cada bloque se
+ * acumula en float con la ganancia y el paneo de cada voz y se vuelve a
+ * S16 con saturacion. Los kernels SSE2 y AVX2 se eligen segun la CPU.
+ *
+ * Formato soportado: S16 nativo, estereo (el que abre initAudio()).
+ */
+
+#ifndef MIXER_H
+#define MIXER_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Comandos que entran en la cola antes de que el hilo de audio la vacie. */
+#define MIXER_RING_SIZE 2048
+
+/** @brief Frames que se acumulan por pasada (el buffer float entra en L1). */
+#define MIXER_BLOCK 256
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Implementacion de los kernels de mezcla.
+ */
+typedef enum {
+    MIXER_KERNEL_SCALAR, /**< @brief C portable. */
+    MIXER_KERNEL_SSE2,   /**< @brief 4 frames por iteracion. */
+    MIXER_KERNEL_AVX2,   /**< @brief 8 frames por iteracion. */
+    MIXER_KERNEL_COUNT
+} MixerKernel;
+
+/**
+ * @brief Contadores del mezclador.
+ */
+typedef struct {
+    int voices;          /**< @brief Voces reservadas. */
+    int active;          /**< @brief Voces sonando al final del ultimo buffer. */
+    int stolen_voices;   /**< @brief Voces cortadas para hacer lugar a un play (no habia voz libre). */
+    int dropped_commands;/**< @brief Comandos descartados porque la cola estaba llena. */
+    MixerKernel kernel;  /**< @brief Kernel en uso. */
+} MixerStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Reserva las voces y elige el mejor kernel para la CPU.
+ *
+ * No toca el dispositivo de audio (el benchmark lo usa asi).
+ * @param voices Voces simultaneas.
+ * @return false si no hay memoria.
+ */
+bool Mixer_Init(int voices);
+
+/**
+ * @brief Engancha la mezcla al callback de SDL_mixer (post-mix).
+ * @return false si el dispositivo no esta abierto o no es S16 estereo.
+ */
+bool Mixer_Attach(void);
+
+/**
+ * @brief Desengancha el mezclador y libera las voces.
+ */
+void Mixer_Quit(void);
+
+/**
+ * @brief Indica si el mezclador esta enganchado al audio.
+ */
+bool Mixer_IsActive(void);
+
+/**
+ * @brief Encola la reproduccion de un chunk (solo desde el hilo del juego).
+ * @param chunk Chunk ya convertido al formato del dispositivo.
+ * @param gain  Ganancia lineal (1 = original). Se multiplica por chunk->volume.
+ * @param pan   -1 izquierda, 0 centro, 1 derecha.
+ *
+ * Si todas las voces estan sonando se corta la que empezo primero, asi
+ * el id devuelto siempre es de un sonido que llega a sonar.
+ * @return Id de la voz (> 0), o -1 si la cola esta llena o no hay mezclador.
+ */
+int Mixer_Play(const Mix_Chunk *chunk, float gain, float pan);
+
+/**
+ * @brief Encola el corte de una voz (si ya termino no hace nada).
+ * @return false si la cola esta llena.
+ */
+bool Mixer_Stop(int voice);
+
+/**
+ * @brief Encola un cambio de ganancia de una voz.
+ * @return false si la cola esta llena.
+ */
+bool Mixer_SetGain(int voice, float gain);
+
+/**
+ * @brief Corta todas las voces y espera a que el hilo de audio lo vea.
+ *
+ * Llamar antes de liberar chunks que puedan estar sonando.
+ */
+void Mixer_Halt(void);
+
+/**
+ * @brief Aplica los comandos pendientes y mezcla las voces sobre 'stream'.
+ *
+ * Lo llama el callback de audio; el benchmark lo llama directo.
+ * @param stream Muestras S16 estereo intercaladas (se suman las voces).
+ * @param frames Frames de 'stream' (0 = solo aplicar comandos).
+ */
+void Mixer_Render(Sint16 *stream, int frames);
+
+/**
+ * @brief Fuerza un kernel (benchmark, con el mezclador sin enganchar).
+ * @return false si la CPU o el compilador no lo soportan, o si esta enganchado.
+ */
+bool Mixer_SetKernel(MixerKernel kernel);
+
+/**
+ * @brief Nombre de un kernel ("escalar", "sse2", "avx2").
+ */
+const char *Mixer_KernelName(MixerKernel kernel);
+
+/**
+ * @brief Devuelve los contadores del mezclador.
+ */
+MixerStats Mixer_GetStats(void);
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file pacer.h
+ * @brief Limitador de framerate de alta precision basado en
+ *        SDL_GetPerformanceCounter.
+ *
+ * Cada frame tiene un deadline absoluto. Pacer_Wait() duerme con
+ * SDL_Delay hasta quedar a unos pocos milisegundos del deadline y cede
+ * la CPU en un bucle corto para el tramo final. El periodo se acumula
+ * en aritmetica entera exacta (incluida la fraccion de tick), de modo
+ * que 60 fps son 16.667 ms en promedio y no 16 ms.
+ */
+
+#ifndef PACER_H
+#define PACER_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Estadisticas de precision del pacing (en microsegundos).
+ *
+ * El error es la diferencia entre el momento en que Pacer_Wait()
+ * retorno y el deadline del frame (positivo = tarde).
+ */
+typedef struct {
+    double last_error_us;     /**< @brief Error del ultimo frame. */
+    double mean_abs_error_us; /**< @brief Promedio del error absoluto. */
+    double max_error_us;      /**< @brief Mayor error absoluto observado. */
+    Uint64 frames;            /**< @brief Frames medidos desde el ultimo reset. */
+    Uint64 resyncs;           /**< @brief Frames que llegaron mas de un periodo tarde (deadline reiniciado). */
+} PacerStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Inicializa el pacer con un framerate objetivo.
+ * @param fps Frames por segundo objetivo. 0 o negativo = sin limite.
+ */
+void Pacer_Init(int fps);
+
+/**
+ * @brief Espera hasta el deadline del frame actual y agenda el siguiente.
+ *
+ * Si el frame ya llego tarde mas de un periodo completo, no intenta
+ * recuperar: reinicia el deadline desde el instante actual.
+ */
+void Pacer_Wait(void);
+
+/**
+ * @brief Devuelve las estadisticas acumuladas desde el ultimo reset.
+ * @return Copia de las estadisticas.
+ */
+PacerStats Pacer_GetStats(void);
+
+/**
+ * @brief Reinicia las estadisticas de precision.
+ */
+void Pacer_ResetStats(void);
+
+#endif
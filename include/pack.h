@@ -0,0 +1,180 @@
+/**
+ * @file pack.h
+ * @brief Paquete binario de assets mapeado en memoria.
+ *
+ * Un solo archivo (PACK_FILE) con los assets ya decodificados:
+ * - Imagenes: pixeles en el formato de las paginas del atlas, listos para
+ *   componer y subir sin pasar por SDL_image.
+ * - Sonidos: PCM crudo en el formato del mixer, para Mix_QuickLoad_RAW.
+ * - Datos: bytes tal cual (JSON, etc).
+ *
+ * Estructura (little-endian, offsets desde el inicio del archivo):
+ * @code
+ * PackHeader | blobs alineados a PACK_ALIGN ... | tabla de nombres | PackEntry[] (por hash)
+ * @endcode
+ *
+ * Las entradas se buscan por el hash FNV-1a de su ruta tal como la abriria
+ * el cargador de archivos sueltos (p. ej. "assets/sprites/x.png"). Los
+ * cargadores consultan primero el paquete y, si no esta abierto o no
+ * contiene la ruta, leen el archivo suelto.
+ *
+ * El paquete se genera con `make pack` (binario compilado con PACK_MAIN).
+ * Las superficies y chunks creados desde el paquete apuntan a la memoria
+ * mapeada: Pack_Close() debe llamarse despues de liberarlos.
+ */
+
+#ifndef PACK_H
+#define PACK_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <stdbool.h>
+
+#include "config.h"
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Ruta del paquete que busca Game_Init. */
+#define PACK_FILE ASSETS_DIR "assets.pak"
+
+/** @brief Firma del archivo ("SPAK"). */
+#define PACK_MAGIC 0x4B415053u
+
+/** @brief Version del formato. */
+#define PACK_VERSION 1
+
+/** @brief Alineacion de cada blob (bytes). */
+#define PACK_ALIGN 64
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Tipo de contenido de una entrada.
+ */
+typedef enum {
+    PACK_IMAGE = 1, /**< @brief Pixeles de 32 bits (width, height, pitch). */
+    PACK_SOUND = 2, /**< @brief PCM en el formato de audio del header. */
+    PACK_DATA  = 3  /**< @brief Bytes sin procesar. */
+} PackType;
+
+/**
+ * @brief Cabecera del paquete (48 bytes).
+ */
+typedef struct {
+    Uint32 magic;          /**< @brief PACK_MAGIC. */
+    Uint32 version;        /**< @brief PACK_VERSION. */
+    Uint32 entry_count;    /**< @brief Entradas en la tabla de contenidos. */
+    Uint32 pixel_format;   /**< @brief SDL_PIXELFORMAT_* de las imagenes. */
+    Sint32 audio_freq;     /**< @brief Frecuencia del PCM (Hz). */
+    Uint16 audio_format;   /**< @brief AUDIO_* del PCM. */
+    Uint16 audio_channels; /**< @brief Canales del PCM. */
+    Uint64 toc_offset;     /**< @brief Offset de PackEntry[entry_count]. */
+    Uint64 names_offset;   /**< @brief Offset de la tabla de nombres. */
+    Uint64 names_size;     /**< @brief Tamanho de la tabla de nombres. */
+} PackHeader;
+
+/**
+ * @brief Entrada de la tabla de contenidos (48 bytes). Ordenadas por hash.
+ */
+typedef struct {
+    Uint64 hash;     /**< @brief hashString() de la ruta. */
+    Uint64 offset;   /**< @brief Offset del blob (multiplo de PACK_ALIGN). */
+    Uint64 size;     /**< @brief Tamanho del blob en bytes. */
+    Uint32 name;     /**< @brief Offset de la ruta en la tabla de nombres. */
+    Uint32 type;     /**< @brief PackType. */
+    Uint32 width;    /**< @brief Imagenes: ancho en pixeles. */
+    Uint32 height;   /**< @brief Imagenes: alto en pixeles. */
+    Uint32 pitch;    /**< @brief Imagenes: bytes por fila. */
+    Uint32 reserved; /**< @brief Sin uso (0). */
+} PackEntry;
+
+// ============================================================
+// Apertura y cierre
+// ============================================================
+
+/**
+ * @brief Mapea el paquete en memoria y valida su cabecera y tabla.
+ * @param path Ruta del archivo.
+ * @return true si quedo abierto, false si no existe o es invalido.
+ */
+bool Pack_Open(const char *path);
+
+/**
+ * @brief Desmapea el paquete. Liberar antes las superficies y chunks creados desde el.
+ */
+void Pack_Close(void);
+
+/**
+ * @brief Indica si hay un paquete abierto.
+ * @return true si hay un paquete abierto.
+ */
+bool Pack_IsOpen(void);
+
+// ============================================================
+// Consulta
+// ============================================================
+
+/**
+ * @brief Busca una entrada por ruta.
+ * @param path Ruta del asset (igual a la del archivo suelto).
+ * @return Entrada, o NULL si no hay paquete o no contiene la ruta.
+ */
+const PackEntry *Pack_Find(const char *path);
+
+/**
+ * @brief Puntero a los bytes de una entrada (memoria mapeada, solo lectura).
+ * @param e Entrada.
+ * @return Puntero al blob.
+ */
+const void *Pack_Data(const PackEntry *e);
+
+/**
+ * @brief Lista los archivos de un tipo que estan directamente en 'dir'.
+ *
+ * Devuelve los nombres sin el directorio, igual que getFilesFromDir(),
+ * por lo que se liberan con freeStringArray().
+ * @param dir      Directorio (con '/' final, p. ej. SPRITES_DIR).
+ * @param type     Tipo de entrada a listar.
+ * @param outCount Recibe la cantidad de nombres.
+ * @return Array de nombres, o NULL si no hay paquete o ninguna entrada coincide.
+ */
+char **Pack_ListDir(const char *dir, PackType type, int *outCount);
+
+// ============================================================
+// Creacion de recursos
+// ============================================================
+
+/**
+ * @brief Crea una superficie que apunta a los pixeles del paquete (sin copia).
+ * @param e Entrada de tipo PACK_IMAGE.
+ * @return Superficie (liberar con SDL_FreeSurface), o NULL en caso de error.
+ */
+SDL_Surface *Pack_CreateSurface(const PackEntry *e);
+
+/**
+ * @brief Indica si el mixer esta abierto con el formato de audio del paquete.
+ *
+ * No escribe en el log: se puede llamar desde un worker.
+ * @return false si no coincide, si no hay paquete o si el mixer no esta abierto.
+ */
+bool Pack_AudioMatches(void);
+
+/**
+ * @brief Crea un chunk que reproduce el PCM del paquete (sin copia).
+ *
+ * Solo funciona si el mixer se abrio con el mismo formato que el del
+ * paquete (ver Pack_AudioMatches()); si no, devuelve NULL y hay que
+ * cargar el archivo suelto. No escribe en el log.
+ * @param e Entrada de tipo PACK_SOUND.
+ * @return Chunk (liberar con Mix_FreeChunk), o NULL.
+ */
+Mix_Chunk *Pack_CreateChunk(const PackEntry *e);
+
+#endif
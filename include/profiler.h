@@ -0,0 +1,89 @@
+/**
+ * @file profiler.h
+ * @brief Medicion de tiempos por fase del frame (input, update, render).
+ *
+ * Guarda una muestra por frame y fase en buffers reservados de antemano
+ * (sin allocs durante el loop). Al terminar calcula media, percentiles
+ * y maximo, y puede volcarlos como JSON para comparar corridas en CI.
+ * Sin Prof_Init(), Prof_Begin/Prof_End no hacen nada.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Fases medidas de cada frame.
+ */
+typedef enum {
+    PROF_INPUT,       /**< @brief Game_KeyboardInput. */
+    PROF_UPDATE,      /**< @brief Game_UpdateFrame (ticks de simulacion + pacing). */
+    PROF_RENDER,      /**< @brief Game_Render (incluye SDL_RenderPresent). */
+    PROF_FRAME,       /**< @brief Frame completo. */
+    PROF_PHASE_COUNT
+} ProfPhase;
+
+/**
+ * @brief Estadisticas de una fase (en milisegundos).
+ */
+typedef struct {
+    int    samples; /**< @brief Muestras registradas. */
+    double mean;    /**< @brief Promedio. */
+    double p50;     /**< @brief Mediana. */
+    double p95;     /**< @brief Percentil 95. */
+    double p99;     /**< @brief Percentil 99. */
+    double max;     /**< @brief Peor muestra. */
+} ProfStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Reserva espacio para 'maxFrames' muestras por fase.
+ * @param maxFrames Muestras maximas por fase (las siguientes se ignoran).
+ * @return true si se reservo la memoria, false en caso de error.
+ */
+bool Prof_Init(int maxFrames);
+
+/**
+ * @brief Libera los buffers de muestras.
+ */
+void Prof_Quit(void);
+
+/**
+ * @brief Marca el inicio de una fase.
+ * @param phase Fase a medir.
+ */
+void Prof_Begin(ProfPhase phase);
+
+/**
+ * @brief Marca el fin de una fase y guarda la duracion desde Prof_Begin.
+ * @param phase Fase medida.
+ */
+void Prof_End(ProfPhase phase);
+
+/**
+ * @brief Calcula las estadisticas de una fase.
+ * @param phase Fase a consultar.
+ * @return Estadisticas (todo en cero si no hay muestras).
+ */
+ProfStats Prof_GetStats(ProfPhase phase);
+
+/**
+ * @brief Escribe las estadisticas de todas las fases como un objeto JSON.
+ * @param out Archivo de salida (p. ej. stdout).
+ */
+void Prof_PrintJSON(FILE *out);
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file renderqueue.h
+ * @brief Cola de comandos de render ordenada por clave de 64 bits.
+ *
+ * Cada dibujo se encola como un comando compacto (rango de quads +
+ * clave). Al cerrar el frame las claves se ordenan con radix sort
+ * (estable) y los comandos consecutivos que comparten textura y blend
+ * mode se envian juntos en un solo SDL_RenderGeometry.
+ *
+ * Clave (bits altos a bajos):
+ * @code
+ * capa (8) | id de textura (16) | blend mode (4) | profundidad (36)
+ * @endcode
+ * Dentro de una capa el orden lo decide la textura, no el orden de
+ * llamada: lo que deba taparse entre si con texturas distintas va en
+ * capas distintas. Con la misma clave se respeta el orden de envio.
+ *
+ * Modo dirty rects (RenderQueue_SetDirtyRects): el resultado de la cola
+ * se retiene en una textura de WIN_W x WIN_H entre frames. Cada flush
+ * compara los comandos con los del frame anterior y solo redibuja las
+ * regiones de lo que se movio, cambio de frame, aparecio o desaparecio;
+ * despues copia la textura retenida al target actual. Pensado para el
+ * renderer por software con escenas mayormente estaticas. Lo que se
+ * dibuja fuera de la cola (debug, GUI) va encima y no se retiene.
+ * Los comandos se comparan por puntero de textura, no por sus pixeles:
+ * quien redibuja una textura de render que pasa por la cola (ej: un chunk
+ * de tilemap) debe avisar con RenderQueue_TextureChanged().
+ *
+ * Uso tipico por frame:
+ * @code
+ * RenderQueue_Begin();
+ * RenderQueue_Sprite(&fondo, RENDER_LAYER_BACKGROUND, 0);
+ * RenderQueue_Sprite(&jugador, RENDER_LAYER_WORLD, (Uint32)jugador.dst.y);
+ * RenderQueue_Flush();
+ * @endcode
+ */
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "sprites.h"
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/**
+ * @brief Capas de uso comun (cualquier valor 0-255 es valido).
+ */
+enum {
+    RENDER_LAYER_BACKGROUND = 0,  /**< @brief Fondos y mapas. */
+    RENDER_LAYER_WORLD      = 64, /**< @brief Personajes y objetos. */
+    RENDER_LAYER_FOREGROUND = 128,/**< @brief Efectos por encima del mundo. */
+    RENDER_LAYER_HUD        = 192 /**< @brief Interfaz. */
+};
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Contadores del ultimo RenderQueue_Flush().
+ */
+typedef struct {
+    int commands;                  /**< @brief Comandos encolados. */
+    int quads;                     /**< @brief Quads encolados. */
+    int draw_calls;                /**< @brief Llamadas a SDL_RenderGeometry emitidas. */
+    int texture_switches;          /**< @brief Cambios de textura entre llamadas (tras ordenar). */
+    int blend_switches;            /**< @brief Cambios de blend mode entre llamadas (tras ordenar). */
+    int unsorted_texture_switches; /**< @brief Cambios de textura que habria en orden de llamada. */
+    double sort_ms;                /**< @brief Tiempo del radix sort. */
+    int dirty_rects;               /**< @brief Regiones redibujadas (modo dirty rects). */
+    float redrawn_pct;             /**< @brief Porcentaje de pixeles de pantalla redibujados. */
+} RenderQueueStats;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Abre la cola del frame (vacia los comandos, conserva la memoria).
+ */
+void RenderQueue_Begin(void);
+
+/**
+ * @brief Encola un sprite (respeta flip y angle).
+ *
+ * Se proyecta con la camara activa y se descarta si queda fuera de
+ * pantalla. Si la cola no esta abierta, se envia a SpriteBatch_Submit().
+ * @param s     Sprite a encolar.
+ * @param layer Capa (se dibuja de menor a mayor).
+ * @param depth Orden dentro de la misma capa y textura (menor primero).
+ */
+void RenderQueue_Sprite(const Sprite *s, Uint8 layer, Uint32 depth);
+
+/**
+ * @brief Encola quads ya armados (4 vertices por quad: TL, TR, BR, BL).
+ *
+ * Si la cola no esta abierta, se envian a SpriteBatch_SubmitQuads().
+ * @param texture   Textura de los quads.
+ * @param vertices  Array de 4 * quadCount vertices (se copian).
+ * @param quadCount Cantidad de quads.
+ * @param layer     Capa.
+ * @param depth     Orden dentro de la misma capa y textura.
+ */
+void RenderQueue_Quads(SDL_Texture *texture, const SDL_Vertex *vertices, int quadCount, Uint8 layer, Uint32 depth);
+
+/**
+ * @brief Ordena los comandos, los despacha agrupados y cierra la cola.
+ */
+void RenderQueue_Flush(void);
+
+/**
+ * @brief Indica si hay una cola abierta (entre Begin y Flush).
+ */
+bool RenderQueue_IsOpen(void);
+
+/**
+ * @brief Activa o desactiva el modo dirty rects.
+ *
+ * Al activarlo se crea (o recrea) la textura retenida y el siguiente
+ * frame se redibuja completo.
+ * @param enabled true para activar.
+ * @return false si el renderer no soporta texturas de render (el modo queda apagado).
+ */
+bool RenderQueue_SetDirtyRects(bool enabled);
+
+/**
+ * @brief Indica si el modo dirty rects esta activo (el flush cubre toda la pantalla).
+ */
+bool RenderQueue_IsRetained(void);
+
+/**
+ * @brief Fuerza a redibujar todo en el proximo flush (ej: tras SDL_RENDER_TARGETS_RESET).
+ */
+void RenderQueue_Invalidate(void);
+
+/**
+ * @brief Avisa que cambio el contenido de una textura (ej: un target redibujado).
+ *
+ * En modo dirty rects, lo que se dibuje con esa textura se considera
+ * distinto del frame anterior y su region se redibuja. Sin el modo
+ * activo no hace nada.
+ * @param texture Textura cuyos pixeles cambiaron.
+ */
+void RenderQueue_TextureChanged(SDL_Texture *texture);
+
+/**
+ * @brief Devuelve los contadores del ultimo flush.
+ * @return Copia de los contadores.
+ */
+RenderQueueStats RenderQueue_GetStats(void);
+
+/**
+ * @brief Libera los buffers de la cola. Llamar desde Game_Destroy().
+ */
+void RenderQueue_Destroy(void);
+
+#endif
@@ -0,0 +1,86 @@
+/**
+ * @file screen.h
+ * @brief Render a resolucion logica con un solo escalado entero al presentar.
+ *
+ * Con el target activo, todo el frame se dibuja en una textura de
+ * WIN_W x WIN_H (la resolucion del .ini) y al presentar se copia una
+ * sola vez a la ventana, escalada por el mayor entero que entra y
+ * centrada con bandas negras. El costo de relleno de cada sprite queda
+ * proporcional a la resolucion logica y los pixeles no titilan con
+ * escalas fraccionarias.
+ *
+ * Sin el target se mantiene el camino anterior: SDL_RenderSetScale con
+ * la escala (no entera) de la ventana.
+ *
+ * Uso tipico por frame:
+ * @code
+ * Screen_BeginFrame();
+ * // ... dibujar en coordenadas logicas ...
+ * Screen_Present();
+ * @endcode
+ */
+
+#ifndef SCREEN_H
+#define SCREEN_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Configura la pantalla para el renderer global.
+ * @param logicalW  Ancho logico (pixeles del juego).
+ * @param logicalH  Alto logico.
+ * @param useTarget true para dibujar en una textura logica y escalarla al presentar.
+ * @return true si el modo pedido quedo activo (false = se usa el escalado por render).
+ */
+bool Screen_Init(int logicalW, int logicalH, bool useTarget);
+
+/**
+ * @brief Recalcula la escala tras un cambio de tamanho de la ventana.
+ * @param winW Ancho nuevo de la ventana.
+ * @param winH Alto nuevo de la ventana.
+ */
+void Screen_Resize(int winW, int winH);
+
+/**
+ * @brief Dirige el dibujo del frame al target logico (no-op sin target).
+ */
+void Screen_BeginFrame(void);
+
+/**
+ * @brief Copia el target escalado a la ventana y presenta el frame.
+ */
+void Screen_Present(void);
+
+/**
+ * @brief Convierte coordenadas de ventana (eventos de mouse) a logicas.
+ *
+ * Los puntos sobre las bandas quedan fuera de [0, WIN_W) x [0, WIN_H).
+ * @param x Coordenada X (entrada y salida).
+ * @param y Coordenada Y (entrada y salida).
+ */
+void Screen_WindowToLogical(int *x, int *y);
+
+/**
+ * @brief Convierte un desplazamiento de ventana (xrel/yrel) a logico.
+ */
+void Screen_WindowDeltaToLogical(int *dx, int *dy);
+
+/**
+ * @brief Indica si se dibuja en el target logico.
+ */
+bool Screen_UsesTarget(void);
+
+/**
+ * @brief Libera el target. Llamar antes de destruir el renderer.
+ */
+void Screen_Destroy(void);
+
+#endif
@@ -19,10 +19,17 @@
 
 /**
  * @brief Libreria de efectos de sonido (SFX).
+ *
+ * Ademas de los chunks guarda sus nombres y una tabla hash (direccionamiento
+ * abierto, hashString del nombre) para buscar un efecto en O(1).
  */
 typedef struct sounds_{
     Mix_Chunk **chunks; /**< @brief Array de chunks de audio cargados. */
     int n;              /**< @brief Numero de chunks en el array. */
+    char **names;       /**< @brief Nombre de archivo de cada chunk (relativo al directorio). */
+    Uint64 *hashes;     /**< @brief hashString() de cada nombre. */
+    int *slots;         /**< @brief Tabla hash: indice del chunk o -1 si el slot esta libre. */
+    int slot_mask;      /**< @brief Cantidad de slots - 1 (potencia de 2). */
 }sfx;
 
 /**
@@ -39,6 +46,8 @@ typedef struct songs{
 
 /**
  * @brief Inicializa el subsistema de audio de SDL y abre el dispositivo de mezcla.
+ *
+ * Si el dispositivo ya esta abierto no hace nada.
  * @return true si la inicializacion fue exitosa, false en caso de error.
  */
 bool initAudio(void);
@@ -53,11 +62,72 @@ void quitAudio(void);
 // ============================================================
 
 /**
- * @brief Reproduce un efecto de sonido una vez y lo libera automaticamente al terminar.
+ * @brief Reproduce un efecto de sonido una vez (equivale a Sound_Play).
+ *
+ * Se mantiene por compatibilidad: el chunk sale del banco de sonidos, ya
+ * no se carga del disco ni se libera al terminar.
  * @param sound Nombre del archivo de sonido (relativo a SFX_DIR).
  */
 void playAndFreeSfx(const char *sound);
 
+// ============================================================
+// Banco de sonidos
+// ============================================================
+
+/**
+ * @brief Carga una sola vez todos los efectos de un directorio en el banco global.
+ *
+ * Llamar despues de initAudio(). Reemplaza el banco anterior si existia.
+ * @param path Directorio de efectos (normalmente SFX_DIR).
+ * @return true si se cargo al menos un efecto.
+ */
+bool Sound_InitBank(char *path);
+
+/**
+ * @brief Libera el banco global. Llamar antes de quitAudio().
+ */
+void Sound_QuitBank(void);
+
+/**
+ * @brief Busca un efecto del banco por nombre.
+ * @param name Nombre del archivo (p. ej. "coin.wav").
+ * @return Id del efecto, o -1 si no esta en el banco.
+ */
+int Sound_Find(const char *name);
+
+/**
+ * @brief Reproduce un efecto del banco por nombre.
+ * @param name Nombre del archivo (p. ej. "coin.wav").
+ * @return Canal usado, o -1 si no esta en el banco o no hay canal libre.
+ */
+int Sound_Play(const char *name);
+
+/**
+ * @brief Reproduce un efecto del banco por id (sin hashear el nombre).
+ * @param id Id devuelto por Sound_Find().
+ * @return Canal usado, o -1 si el id no es valido o no hay canal libre.
+ *         Con el mezclador por software (mixer_voices > 0) devuelve el id
+ *         de la voz: si no hay voz libre se corta la mas vieja, y -1 solo
+ *         indica que la cola de comandos estaba llena.
+ */
+int Sound_PlayId(int id);
+
+/**
+ * @brief Corta un efecto en curso.
+ * @param channel Canal (o voz) devuelto por Sound_Play / Sound_PlayId.
+ */
+void Sound_Stop(int channel);
+
+/**
+ * @brief Cambia la ganancia de un efecto en curso.
+ * @param channel Canal (o voz) devuelto por Sound_Play / Sound_PlayId.
+ * @param gain    Ganancia lineal (con SDL_mixer se satura a 0..1).
+ *
+ * Solo afecta a esa reproduccion: el proximo efecto que use el canal
+ * vuelve a sonar a ganancia completa.
+ */
+void Sound_SetGain(int channel, float gain);
+
 // ============================================================
 // Gestion de librerias de audio
 // ============================================================
@@ -76,6 +146,14 @@ sfx *initSfxLib(char *path);
  */
 music *initMusicLib(char *path);
 
+/**
+ * @brief Busca un efecto de una libreria por nombre (O(1) promedio).
+ * @param lib  Libreria de efectos.
+ * @param name Nombre del archivo (relativo al directorio de la libreria).
+ * @return Indice del chunk, o -1 si no esta.
+ */
+int findSfx(const sfx *lib, const char *name);
+
 /**
  * @brief Libera todos los recursos de una libreria de efectos de sonido.
  * @param cur Puntero a la libreria sfx a liberar (puede ser NULL).
@@ -0,0 +1,109 @@
+/**
+ * @file spatial.h
+ * @brief Indice espacial de grilla uniforme para consultas de visibilidad.
+ *
+ * Cada elemento (un id entero elegido por el caller, ej: indice de un
+ * sprite) se registra con su caja en coordenadas de mundo y queda
+ * anotado en todas las celdas que toca. Una consulta recorre solo las
+ * celdas del area pedida, asi que obtener lo visible cuesta O(visibles)
+ * en lugar de O(todos).
+ *
+ * Los elementos fuera de los limites de la grilla quedan en las celdas
+ * del borde (siguen siendo encontrables, solo que menos eficiente).
+ *
+ * @code
+ * SpatialGrid grid;
+ * Spatial_Init(&grid, (SDL_FRect){0, 0, 8192, 8192}, 128.0f);
+ * Spatial_Insert(&grid, i, sprites[i].dst);
+ * int n = Spatial_Query(&grid, Camera_View(NULL), visibles, maxVisibles);
+ * @endcode
+ */
+
+#ifndef SPATIAL_H
+#define SPATIAL_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Lista de ids anotados en una celda.
+ */
+typedef struct {
+    int *ids;     /**< @brief Ids de los elementos que tocan la celda. */
+    int count;    /**< @brief Ids en uso. */
+    int capacity; /**< @brief Capacidad reservada. */
+} SpatialCell;
+
+/**
+ * @brief Grilla uniforme de elementos con caja.
+ */
+typedef struct {
+    SDL_FRect bounds;      /**< @brief Area cubierta por la grilla (mundo). */
+    float cell_size;       /**< @brief Lado de una celda (mundo). */
+    int cols, rows;        /**< @brief Celdas por eje. */
+    SpatialCell *cells;    /**< @brief cols * rows celdas. */
+
+    SDL_FRect *item_box;   /**< @brief Caja de cada id. */
+    SDL_Rect *item_cells;  /**< @brief Rango de celdas de cada id (x0, y0, x1, y1 inclusive). */
+    Uint32 *item_stamp;    /**< @brief Ultima consulta que devolvio el id (evita duplicados). */
+    Uint8 *item_used;      /**< @brief 1 si el id esta registrado. */
+    int item_capacity;     /**< @brief Ids reservados. */
+    int item_count;        /**< @brief Ids registrados. */
+    Uint32 stamp;          /**< @brief Contador de consultas. */
+} SpatialGrid;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Crea una grilla vacia.
+ * @param grid     Grilla a inicializar.
+ * @param bounds   Area del mundo a cubrir.
+ * @param cellSize Lado de una celda (del orden de la vista o de los objetos grandes).
+ * @return true si se pudo reservar la memoria.
+ */
+bool Spatial_Init(SpatialGrid *grid, SDL_FRect bounds, float cellSize);
+
+/**
+ * @brief Libera la grilla.
+ */
+void Spatial_Free(SpatialGrid *grid);
+
+/**
+ * @brief Registra un id con su caja (si ya existia, equivale a Spatial_Move).
+ * @param grid Grilla.
+ * @param id   Id del elemento (>= 0).
+ * @param box  Caja en coordenadas de mundo.
+ * @return false si no hubo memoria.
+ */
+bool Spatial_Insert(SpatialGrid *grid, int id, SDL_FRect box);
+
+/**
+ * @brief Actualiza la caja de un id. Solo toca celdas si cambia de celdas.
+ */
+void Spatial_Move(SpatialGrid *grid, int id, SDL_FRect box);
+
+/**
+ * @brief Quita un id de la grilla.
+ */
+void Spatial_Remove(SpatialGrid *grid, int id);
+
+/**
+ * @brief Busca los ids cuya caja se superpone con un area.
+ * @param grid Grilla.
+ * @param area Area de consulta (ej: Camera_View()).
+ * @param out  Buffer de ids encontrados (sin duplicados).
+ * @param max  Capacidad de 'out'.
+ * @return Ids escritos en 'out' (como mucho 'max').
+ */
+int Spatial_Query(SpatialGrid *grid, SDL_FRect area, int *out, int max);
+
+#endif
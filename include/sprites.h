@@ -5,6 +5,12 @@
  * Provee las estructuras y funciones para dibujar sprites estáticos,
  * animaciones por frames desde spritesheets, y sprites animados con
  * múltiples estados (idle, walk, etc).
+ *
+ * Los sprites animados no guardan frames: reproducen clips
+ * (AnimationClip) inmutables que se registran una sola vez y se
+ * comparten por id entre todas las instancias. Una Animation sirve para
+ * armar los frames de un clip (Anim_CreateFromSheet, Anim_Offset) antes
+ * de registrarlo con Clip_FromAnimation.
  */
 
 #ifndef SPRITES_H
@@ -15,6 +21,7 @@
 // ============================================================
 #include <SDL_image.h>
 #include <stdbool.h>
+#include "img.h"
 
 // ============================================================
 // Estructuras
@@ -33,6 +40,34 @@ typedef struct {
     bool      finished;       // true cuando terminó (si loop == false)
 } Animation;
 
+/**
+ * @brief Clip de animación inmutable y compartido (se referencia por id).
+ */
+typedef struct {
+    int   first_frame;    // Índice del primer frame en el pool de frames del registro
+    int   frame_count;    // Total de frames
+    float frame_duration; // Segundos por frame
+    bool  loop;           // Si repite al terminar
+} AnimationClip;
+
+/**
+ * @brief Estado de reproducción de un clip (lo único que es propio de cada instancia).
+ *
+ * Dos modos:
+ * - Por ticks (ASprite_Play): ASprite_Update acumula dt en timer/frame.
+ * - Por tiempo (ASprite_PlayAt): solo se guarda el instante de inicio y el
+ *   frame se calcula al dibujar con ASprite_FrameAt. No hace falta llamar a
+ *   ASprite_Update, así que un sprite que no se dibuja no cuesta nada.
+ */
+typedef struct {
+    int    clip;     // Id del clip (-1 = ninguno)
+    int    frame;    // Frame actual dentro del clip (modo por ticks)
+    float  timer;    // Tiempo acumulado en el frame actual (modo por ticks)
+    bool   finished; // true cuando terminó (si el clip no repite, modo por ticks)
+    bool   timed;    // true = modo por tiempo
+    double start;    // Instante de inicio del clip (modo por tiempo, en segundos)
+} AnimState;
+
 /**
  * @brief Sprite: región de una textura con posición, flip y rotación.
  */
@@ -40,18 +75,19 @@ typedef struct {
     SDL_Texture     *texture; // Spritesheet o imagen individual
     SDL_Rect         src;     // Región fuente (qué recortar de la textura)
     SDL_FRect        dst;     // Posición y tamaño en pantalla (float)
+    SDL_FPoint       prev;    // Posición al inicio del tick (para interpolar)
     SDL_RendererFlip flip;    // SDL_FLIP_NONE, SDL_FLIP_HORIZONTAL, SDL_FLIP_VERTICAL
     double           angle;   // Rotación en grados (centro del sprite)
 } Sprite;
 
 /**
- * @brief Sprite animado: sprite con múltiples animaciones (estados).
+ * @brief Sprite animado: sprite base + estado de reproducción del clip activo.
+ *
+ * Cambiar de estado (idle, walk, etc) es reproducir otro clip con ASprite_Play.
  */
 typedef struct {
-    Sprite     sprite;        // Sprite base (textura + posición + flip)
-    Animation *animations;    // Array de animaciones
-    int        anim_count;    // Total de animaciones
-    int        current_anim;  // Índice de la animación activa
+    Sprite    sprite; // Sprite base (textura + posición + flip)
+    AnimState anim;   // Clip activo y su progreso
 } AnimatedSprite;
 
 // ============================================================
@@ -62,26 +98,45 @@ Animation Anim_Create(SDL_Rect *frames, int count, float fps, bool loop);
 Animation Anim_CreateFromSheet(int frameW, int frameH, int cols, int row, int count, float fps, bool loop);
 void      Anim_Update(Animation *a, float dt);
 void      Anim_Reset(Animation *a);
+void      Anim_Offset(Animation *a, int dx, int dy);
 SDL_Rect  Anim_CurrentFrame(Animation *a);
 void      Anim_Free(Animation *a);
 
+// ============================================================
+// AnimationClip (registro global, solo lectura durante los updates)
+// ============================================================
+
+int                  Clip_Register(const SDL_Rect *frames, int count, float fps, bool loop);
+int                  Clip_FromAnimation(const Animation *a);
+const AnimationClip *Clip_Get(int id);
+SDL_Rect             Clip_Frame(int id, int frame);
+int                  Clip_FrameIndexAt(int id, double elapsed, bool *finished);
+int                  Clip_Count(void);
+void                 Clip_FreeAll(void);
+
 // ============================================================
 // Sprite
 // ============================================================
 
 Sprite Sprite_Create(SDL_Texture *tex, SDL_Rect src, float x, float y);
 Sprite Sprite_CreateFull(SDL_Texture *tex, float x, float y);
+Sprite Sprite_CreateFromRegion(TextureRegion region, float x, float y);
 void   Sprite_Draw(Sprite *s);
 void   Sprite_SetPos(Sprite *s, float x, float y);
 void   Sprite_SetFlip(Sprite *s, SDL_RendererFlip flip);
+void   Sprite_StorePrev(Sprite *s);
+Sprite Sprite_Lerp(const Sprite *s, float alpha);
 
 // ============================================================
 // AnimatedSprite
 // ============================================================
 
-AnimatedSprite ASprite_Create(SDL_Texture *tex, Animation *anims, int count, float x, float y);
-void ASprite_Play(AnimatedSprite *as, int animIndex);
+AnimatedSprite ASprite_Create(SDL_Texture *tex, int clip, float x, float y);
+void ASprite_Play(AnimatedSprite *as, int clip);
+void ASprite_PlayAt(AnimatedSprite *as, int clip, double start);
+SDL_Rect ASprite_FrameAt(const AnimatedSprite *as, double now);
 void ASprite_Update(AnimatedSprite *as, float dt);
+void ASprite_UpdateMany(AnimatedSprite *arr, int count, float dt);
 void ASprite_Draw(AnimatedSprite *as);
 void ASprite_Free(AnimatedSprite *as);
 
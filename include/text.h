@@ -1,17 +1,24 @@
 /**
  * @file text.h
- * @brief Sistema de renderizado de texto con cache de texturas SDL.
+ * @brief Sistema de renderizado de texto con atlas de glyphs.
  *
- * Proporciona una API para crear, manipular y dibujar texto en pantalla
- * utilizando SDL_ttf. Las texturas se cachean y solo se re-renderizan
- * cuando el contenido cambia.
+ * Proporciona una API para crear, manipular y dibujar texto en pantalla.
+ * Las fuentes vienen del servicio de fuentes (font.h): cada (ruta,
+ * tamanho) rasteriza una sola vez sus glyphs Latin-1 en paginas de atlas
+ * junto con sus metricas, compartidas con la GUI y las herramientas. Un texto es una lista de quads sobre esas paginas:
+ * Text_Set solo recalcula la distribucion (con kerning) y nunca vuelve a
+ * rasterizar ni a subir texturas.
+ *
+ * Text_Draw emite una llamada SDL_RenderGeometry por pagina del atlas;
+ * dentro de SpriteBatch_Begin/Flush (o de una cola de render) todos los
+ * textos que comparten fuente se dibujan juntos en una sola llamada por pagina.
  */
 
 #ifndef TEXT_H
 #define TEXT_H
 
 #include <SDL.h>
-#include <SDL_ttf.h>
+#include "font.h"
 #include <stdbool.h>
 
 // ============================================================
@@ -30,25 +37,87 @@
 /** @brief Fuente Jersey 10 Regular. */
 #define JERSEY_FONT "Jersey10-Regular.ttf"
 
+// ============================================================
+//  Constantes
+// ============================================================
+
+/** @brief Maximo de paginas de atlas por fuente. */
+#define TEXT_MAX_PAGES FONT_MAX_PAGES
+
+/** @brief Caracteres maximos de un NumberText (signo y separadores incluidos). */
+#define NUMBER_MAX_CHARS 24
+
+/** @brief Caracteres que sabe dibujar un NumberText. */
+#define NUMBER_CHARSET "0123456789-:"
+
+/** @brief Rellena el ancho fijo con ceros en lugar de espacios. */
+#define NUMBER_LEADING_ZEROS 0x01
+
+/** @brief 'x' es el borde derecho del numero en lugar del izquierdo. */
+#define NUMBER_ALIGN_RIGHT 0x02
+
 // ============================================================
 //  Tipos
 // ============================================================
 
 /**
- * @brief Estructura de texto con cache de textura.
+ * @brief Estructura de texto con su geometria ya distribuida.
  *
- * Almacena toda la informacion necesaria para renderizar y dibujar
- * un texto en pantalla, incluyendo una textura cacheada que solo
- * se regenera cuando el contenido cambia.
+ * Guarda los quads de cada glyph (agrupados por pagina del atlas), que
+ * solo se recalculan cuando el contenido cambia. Mover el texto o
+ * cambiar su color solo actualiza los vertices al dibujar.
  */
 typedef struct {
-    SDL_Texture *texture;   /**< @brief Textura cacheada del texto renderizado. */
     SDL_Rect rect;          /**< @brief Posicion (x, y) y dimensiones (w, h) en pantalla. */
     SDL_Color color;        /**< @brief Color RGBA del texto. */
-    TTF_Font *font;         /**< @brief Puntero a la fuente TTF utilizada. */
+    Font *font;             /**< @brief Fuente del servicio (el texto no guarda una referencia). */
     char *content;          /**< @brief Cadena con el texto actual (usada para comparar cambios). */
+
+    SDL_Vertex *vertices;   /**< @brief 4 vertices por glyph visible, agrupados por pagina. */
+    int quad_count;         /**< @brief Quads en uso. */
+    int capacity;           /**< @brief Quads reservados en 'vertices'. */
+    int page_quads[TEXT_MAX_PAGES]; /**< @brief Quads de cada pagina (en orden). */
+    SDL_Point laid_at;      /**< @brief Posicion con la que se generaron los vertices. */
+    SDL_Color laid_color;   /**< @brief Color con el que se generaron los vertices. */
 } Text;
 
+/**
+ * @brief Quad de un caracter de NUMBER_CHARSET, relativo a su celda.
+ */
+typedef struct {
+    SDL_FRect dst;          /**< @brief Rect del glyph dentro de la celda (w = 0: sin imagen). */
+    float u0, v0, u1, v1;   /**< @brief UVs en la pagina del atlas. */
+    int page;               /**< @brief Pagina del atlas (-1 = sin imagen). */
+} NumberGlyph;
+
+/**
+ * @brief Numero de HUD (puntaje, timer, FPS) con geometria fija.
+ *
+ * Los quads de los digitos y la puntuacion se preparan una vez al
+ * crearlo. Cambiar el valor solo vuelve a elegir que quad va en cada
+ * celda: sin snprintf, sin memoria dinamica y sin tocar texturas. Todas
+ * las celdas miden lo mismo (el digito mas ancho), asi el numero no
+ * tiembla al cambiar.
+ */
+typedef struct {
+    SDL_Point pos;          /**< @brief Borde izquierdo (o derecho con NUMBER_ALIGN_RIGHT) y borde superior. */
+    SDL_Color color;        /**< @brief Color RGBA. */
+    Font *font;             /**< @brief Fuente del servicio (sin referencia propia). */
+    int digits;             /**< @brief Ancho fijo en caracteres (0 = el que haga falta). */
+    Uint8 flags;            /**< @brief NUMBER_LEADING_ZEROS | NUMBER_ALIGN_RIGHT. */
+    int cell_w;             /**< @brief Ancho de cada celda. */
+    int h;                  /**< @brief Alto del numero. */
+
+    NumberGlyph glyphs[sizeof(NUMBER_CHARSET) - 1]; /**< @brief Quads de NUMBER_CHARSET. */
+    char chars[NUMBER_MAX_CHARS]; /**< @brief Caracteres mostrados (sin terminador). */
+    int length;             /**< @brief Caracteres en uso. */
+    SDL_Vertex vertices[NUMBER_MAX_CHARS * 4]; /**< @brief Quads agrupados por pagina. */
+    int quad_count;         /**< @brief Quads en uso. */
+    int page_quads[TEXT_MAX_PAGES]; /**< @brief Quads de cada pagina (en orden). */
+    SDL_Point laid_at;      /**< @brief Posicion con la que se generaron los vertices. */
+    SDL_Color laid_color;   /**< @brief Color con el que se generaron los vertices. */
+} NumberText;
+
 // ============================================================
 //  Sistema de texto
 // ============================================================
@@ -65,10 +134,10 @@ typedef struct {
 bool Text_InitSystem(const char *fontPath, int defaultSize);
 
 /**
- * @brief Cierra el sistema de texto y libera la fuente por defecto.
+ * @brief Cierra el sistema de texto y suelta la fuente por defecto.
  *
- * Llama a TTF_Quit() internamente. Debe invocarse al finalizar el uso
- * del modulo de texto.
+ * TTF_Quit() lo hace Font_QuitSystem(), despues de que los demas
+ * usuarios del servicio sueltan sus fuentes.
  */
 void Text_QuitSystem(void);
 
@@ -98,19 +167,35 @@ Text Text_Create(const char *content, int x, int y);
 Text Text_CreateColored(const char *content, int x, int y, SDL_Color color);
 
 /**
- * @brief Actualiza el contenido del texto (solo re-renderiza si cambia).
+ * @brief Actualiza el contenido del texto (solo redistribuye si cambia).
  *
  * Compara el contenido nuevo con el actual; si son iguales no realiza
- * ninguna operacion, evitando re-renderizados innecesarios.
+ * ninguna operacion. Si cambia, recalcula los quads sobre el atlas de
+ * la fuente sin rasterizar nada.
  *
  * @param text Puntero al objeto Text a actualizar.
  * @param content Nueva cadena de texto. Puede ser NULL para limpiar.
  */
 void Text_Set(Text *text, const char *content);
 
+/**
+ * @brief Cambia la fuente de un texto (ej: una fuente pedida con Font_Acquire).
+ *
+ * El texto no suma una referencia: quien pidio la fuente la mantiene
+ * mientras el texto la use.
+ *
+ * @param text Puntero al objeto Text.
+ * @param font Fuente nueva.
+ */
+void Text_SetFont(Text *text, Font *font);
+
 /**
  * @brief Dibuja el texto en pantalla usando el renderer global.
  *
+ * Una llamada SDL_RenderGeometry por pagina del atlas, o ninguna si hay
+ * una cola de render (capa RENDER_LAYER_HUD) o un SpriteBatch abierto
+ * (los quads se agregan ahi).
+ *
  * @param text Puntero al objeto Text a dibujar.
  */
 void Text_Draw(Text *text);
@@ -118,10 +203,45 @@ void Text_Draw(Text *text);
 /**
  * @brief Libera todos los recursos asociados a un objeto Text.
  *
- * Destruye la textura y libera la cadena de contenido.
+ * Libera los vertices y la cadena de contenido (el atlas es de la fuente).
  *
  * @param text Puntero al objeto Text a liberar.
  */
 void Text_Free(Text *text);
 
+// ============================================================
+//  Texto numerico
+// ============================================================
+
+/**
+ * @brief Prepara un numero de HUD con los glyphs de una fuente.
+ *
+ * @param font   Fuente (NULL = la fuente por defecto del sistema de texto).
+ * @param x      Borde izquierdo, o derecho con NUMBER_ALIGN_RIGHT.
+ * @param y      Borde superior.
+ * @param digits Ancho fijo en caracteres, signo incluido (0 = variable).
+ *               Un valor que no entra se satura (ej: 999999 con 6).
+ * @param flags  NUMBER_LEADING_ZEROS y/o NUMBER_ALIGN_RIGHT.
+ * @return Numero sin valor (no dibuja nada hasta el primer Set).
+ */
+NumberText NumberText_Create(Font *font, int x, int y, int digits, Uint8 flags);
+
+/**
+ * @brief Muestra un entero.
+ * @return true si cambio lo que se ve (para marcar sucia la capa del HUD).
+ */
+bool NumberText_Set(NumberText *number, long value);
+
+/**
+ * @brief Muestra un tiempo como M:SS (los minutos ocupan digits - 3).
+ * @return true si cambio lo que se ve.
+ */
+bool NumberText_SetTime(NumberText *number, int seconds);
+
+/**
+ * @brief Dibuja el numero igual que Text_Draw (una llamada por pagina o
+ *        al batch / cola abiertos).
+ */
+void NumberText_Draw(NumberText *number);
+
 #endif
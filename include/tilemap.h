@@ -0,0 +1,130 @@
+/**
+ * @file tilemap.h
+ * @brief Mapas de tiles con capas estaticas horneadas en chunks.
+ *
+ * El mapa guarda un indice de tile (Uint16) por celda. Para dibujarlo,
+ * cada bloque de celdas se hornea una vez en una textura de render
+ * (chunk) de hasta TILEMAP_CHUNK_SIZE pixeles de lado; por frame solo se
+ * copian los chunks que tocan la vista. Cambiar un tile marca su chunk
+ * como sucio y solo ese chunk se vuelve a hornear.
+ *
+ * Los tiles se numeran en orden de lectura dentro de la region del
+ * tileset (fila por fila). TILEMAP_EMPTY deja la celda transparente.
+ *
+ * Uso tipico:
+ * @code
+ * Tilemap map;
+ * Tilemap_Create(&map, 128, 128, 16, 16, dungeonTiles);
+ * Tilemap_Set(&map, 3, 4, 12);
+ * ...
+ * Tilemap_Draw(&map, RENDER_LAYER_BACKGROUND); // cada frame, con la camara activa
+ * @endcode
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+// ============================================================
+// Includes
+// ============================================================
+#include <SDL.h>
+#include <stdbool.h>
+
+#include "img.h"
+
+// ============================================================
+// Constantes
+// ============================================================
+
+/** @brief Lado maximo de un chunk en pixeles. */
+#define TILEMAP_CHUNK_SIZE 256
+
+/** @brief Indice de celda vacia (no se dibuja). */
+#define TILEMAP_EMPTY 0xFFFF
+
+// ============================================================
+// Tipos
+// ============================================================
+
+/**
+ * @brief Mapa de tiles y sus chunks horneados.
+ */
+typedef struct {
+    int width, height;        /**< @brief Tamanho en celdas. */
+    int tile_w, tile_h;       /**< @brief Tamanho de un tile en pixeles. */
+    float x, y;               /**< @brief Origen del mapa en coordenadas de mundo. */
+    Uint16 *tiles;            /**< @brief width * height indices (fila por fila). */
+
+    TextureRegion tileset;    /**< @brief Region con los tiles (puede estar en un atlas). */
+    int tileset_cols;         /**< @brief Tiles por fila del tileset. */
+    int tileset_count;        /**< @brief Tiles en el tileset. */
+
+    int chunk_cols, chunk_rows; /**< @brief Celdas por chunk (horizontal, vertical). */
+    int chunks_x, chunks_y;     /**< @brief Cantidad de chunks. */
+    SDL_Texture **chunks;       /**< @brief Textura de cada chunk (NULL = aun no creada o vacio). */
+    Uint8 *dirty;               /**< @brief 1 si el chunk debe hornearse de nuevo. */
+    bool baked;                 /**< @brief false si el renderer no soporta targets (se dibuja por tile). */
+    int last_bakes;             /**< @brief Chunks horneados en el ultimo Tilemap_Draw o Tilemap_Bake. */
+} Tilemap;
+
+// ============================================================
+// API
+// ============================================================
+
+/**
+ * @brief Crea un mapa vacio (todas las celdas TILEMAP_EMPTY).
+ * @param map     Mapa a inicializar.
+ * @param width   Ancho en celdas.
+ * @param height  Alto en celdas.
+ * @param tileW   Ancho de un tile en pixeles.
+ * @param tileH   Alto de un tile en pixeles.
+ * @param tileset Region del tileset.
+ * @return true si se pudo reservar la memoria.
+ */
+bool Tilemap_Create(Tilemap *map, int width, int height, int tileW, int tileH, TextureRegion tileset);
+
+/**
+ * @brief Libera las celdas y las texturas de los chunks.
+ */
+void Tilemap_Free(Tilemap *map);
+
+/**
+ * @brief Cambia una celda y marca su chunk como sucio (si el valor cambio).
+ */
+void Tilemap_Set(Tilemap *map, int tx, int ty, Uint16 tile);
+
+/**
+ * @brief Devuelve una celda (TILEMAP_EMPTY fuera del mapa).
+ */
+Uint16 Tilemap_Get(const Tilemap *map, int tx, int ty);
+
+/**
+ * @brief Marca todos los chunks como sucios (ej: tras SDL_RENDER_TARGETS_RESET).
+ */
+void Tilemap_Invalidate(Tilemap *map);
+
+/**
+ * @brief Hornea todos los chunks sucios (precarga). Tilemap_Draw hornea
+ *        por su cuenta los chunks sucios que quedan a la vista.
+ *
+ * Preserva el target, la escala y el viewport del renderer.
+ * @return Cantidad de chunks horneados.
+ */
+int Tilemap_Bake(Tilemap *map);
+
+/**
+ * @brief Encola en la cola de render los chunks que tocan la vista de la
+ *        camara activa (en coordenadas de mundo).
+ * @param map   Mapa.
+ * @param layer Capa de render.
+ * @return Cantidad de copias encoladas.
+ */
+int Tilemap_Draw(Tilemap *map, Uint8 layer);
+
+/**
+ * @brief Encola un quad por tile visible, sin chunks (referencia y respaldo).
+ * @return Cantidad de tiles encolados.
+ */
+int Tilemap_DrawTiles(const Tilemap *map, Uint8 layer);
+
+#endif
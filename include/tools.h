@@ -35,6 +35,9 @@
 /** @brief Marca una variable como intencionalmente no utilizada. */
 #define UNUSED(x) ((void)(x))
 
+/** @brief Valor inicial de los hashes FNV-1a de 64 bits (offset basis). */
+#define HASH_SEED 0xcbf29ce484222325ULL
+
 // ============================================================
 // Tipos
 // ============================================================
@@ -112,6 +115,25 @@ typedef enum
  */
 int recBinarySearch(int arr[], int left, int right, int key);
 
+/**
+ * @brief Hash FNV-1a de 64 bits de un string terminado en '\0'.
+ *
+ * @param str String a hashear.
+ * @return Uint64 Hash del string (el de "" si str es NULL).
+ */
+Uint64 hashString(const char *str);
+
+/**
+ * @brief Hash FNV-1a de 64 bits de un bloque de bytes.
+ *
+ * Para encadenar varios bloques se pasa el resultado anterior como 'hash'.
+ * @param data Bytes a hashear.
+ * @param size Cantidad de bytes.
+ * @param hash Valor inicial (HASH_SEED para empezar).
+ * @return Uint64 Hash acumulado.
+ */
+Uint64 hashBytes(const void *data, size_t size, Uint64 hash);
+
 // ============================================================
 // Sistema de archivos
 // ============================================================
@@ -2,18 +2,51 @@
 #ifndef MAIN_DEBUG
 
 #include "engine.h"
+#include "config.h"
+#include "profiler.h"
 
-int main()
+// Uso: ./game [--headless N]
+// Con --headless (o headless_frames en el .ini) corre N frames sin ventana,
+// sin limite de fps, y al salir imprime los tiempos por fase como JSON.
+int main(int argc, char **argv)
 {
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--headless") && i + 1 < argc)
+            Game_SetHeadless(atoi(argv[++i]));
+    }
+
     INSTANCE = Game_Init();
     if(INSTANCE)
     {
         Game_Setup();
-        while(INSTANCE)
+
+        int frames = config.headless_frames;
+        if (frames > 0 && !Prof_Init(frames))
+            frames = 0;
+
+        for (int frame = 0; INSTANCE; frame++)
         {
+            Prof_Begin(PROF_FRAME);
+            Prof_Begin(PROF_INPUT);
             Game_KeyboardInput();
+            Prof_End(PROF_INPUT);
+            Prof_Begin(PROF_UPDATE);
             Game_UpdateFrame();
+            Prof_End(PROF_UPDATE);
+            Prof_Begin(PROF_RENDER);
             Game_Render();
+            Prof_End(PROF_RENDER);
+            Prof_End(PROF_FRAME);
+
+            if (frames > 0 && frame + 1 >= frames)
+                INSTANCE = false;
+        }
+
+        if (frames > 0)
+        {
+            Prof_PrintJSON(stdout);
+            Prof_Quit();
         }
     }
     else
@@ -0,0 +1,347 @@
+/**
+ * @file atlas.c
+ * @brief Implementacion del empaquetador skyline y la composicion de paginas.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "atlas.h"
+#include "engine.h"
+#include "tools.h"
+
+// ============================================================
+// Tipos privados
+// ============================================================
+
+// Segmento horizontal del "horizonte": desde x, w pixeles de ancho, ocupado hasta y.
+typedef struct {
+    int x, y, w;
+} SkylineNode;
+
+typedef struct {
+    SkylineNode *nodes;
+    int          count;
+    int          w, h;         // Tamanho maximo de la pagina
+    int          usedW, usedH; // Extension realmente ocupada
+} AtlasPage;
+
+typedef struct {
+    int index;
+    int w, h;
+} PackItem;
+
+// ============================================================
+// Skyline (static)
+// ============================================================
+
+static bool pageInit(AtlasPage *p, int w, int h)
+{
+    // Cada nodo mide al menos 1 px: nunca hay mas de w + 1 nodos
+    p->nodes = malloc((size_t)(w + 1) * sizeof(SkylineNode));
+    if (!p->nodes)
+        return false;
+    p->nodes[0] = (SkylineNode){0, 0, w};
+    p->count = 1;
+    p->w = w;
+    p->h = h;
+    p->usedW = 0;
+    p->usedH = 0;
+    return true;
+}
+
+// Altura a la que apoya un rect w x h que empieza en el nodo i (-1 si no cabe).
+static int skylineFit(const AtlasPage *p, int i, int w, int h)
+{
+    if (p->nodes[i].x + w > p->w)
+        return -1;
+
+    int y = 0;
+    for (int j = i, left = w; left > 0; j++)
+    {
+        if (p->nodes[j].y > y)
+            y = p->nodes[j].y;
+        if (y + h > p->h)
+            return -1;
+        left -= p->nodes[j].w;
+    }
+    return y;
+}
+
+// Bottom-left: elige la posicion con el borde superior mas bajo
+// (a igualdad, el segmento mas angosto para dejar huecos grandes libres).
+static bool skylineInsert(AtlasPage *p, int w, int h, int *outX, int *outY)
+{
+    int best = -1, bestTop = INT_MAX, bestW = INT_MAX;
+    for (int i = 0; i < p->count; i++)
+    {
+        int y = skylineFit(p, i, w, h);
+        if (y < 0)
+            continue;
+        if (y + h < bestTop || (y + h == bestTop && p->nodes[i].w < bestW))
+        {
+            best    = i;
+            bestTop = y + h;
+            bestW   = p->nodes[i].w;
+        }
+    }
+    if (best < 0)
+        return false;
+
+    int x = p->nodes[best].x;
+    memmove(&p->nodes[best + 1], &p->nodes[best], (size_t)(p->count - best) * sizeof(SkylineNode));
+    p->nodes[best] = (SkylineNode){x, bestTop, w};
+    p->count++;
+
+    // Recortar (o quitar) los segmentos que quedaron debajo del nuevo
+    for (int i = best + 1; i < p->count; i++)
+    {
+        SkylineNode *prev = &p->nodes[i - 1];
+        SkylineNode *cur  = &p->nodes[i];
+        int overlap = prev->x + prev->w - cur->x;
+        if (overlap <= 0)
+            break;
+        cur->x += overlap;
+        cur->w -= overlap;
+        if (cur->w > 0)
+            break;
+        memmove(cur, cur + 1, (size_t)(p->count - i - 1) * sizeof(SkylineNode));
+        p->count--;
+        i--;
+    }
+
+    // Unir segmentos vecinos a la misma altura
+    for (int i = 0; i + 1 < p->count; i++)
+    {
+        if (p->nodes[i].y != p->nodes[i + 1].y)
+            continue;
+        p->nodes[i].w += p->nodes[i + 1].w;
+        memmove(&p->nodes[i + 1], &p->nodes[i + 2], (size_t)(p->count - i - 2) * sizeof(SkylineNode));
+        p->count--;
+        i--;
+    }
+
+    if (x + w > p->usedW)
+        p->usedW = x + w;
+    if (bestTop > p->usedH)
+        p->usedH = bestTop;
+    *outX = x;
+    *outY = bestTop - h;
+    return true;
+}
+
+// Mas alto primero; a igual altura, mas ancho primero.
+static int compareItems(const void *a, const void *b)
+{
+    const PackItem *x = a;
+    const PackItem *y = b;
+    if (x->h != y->h)
+        return y->h - x->h;
+    return y->w - x->w;
+}
+
+// ============================================================
+// Composicion (static)
+// ============================================================
+
+// Copia 'src' en 'dst' de la pagina y repite sus bordes 'padding' pixeles hacia afuera.
+// Si 'src' ya esta en el formato de la pagina, el blit es una copia directa.
+static bool blitExtruded(SDL_Surface *page, SDL_Surface *src, SDL_Rect dst, int padding)
+{
+    SDL_Surface *conv = src;
+    if (src->format->format != page->format->format)
+    {
+        conv = SDL_ConvertSurfaceFormat(src, page->format->format, 0);
+        if (!conv)
+            return false;
+    }
+    SDL_BlendMode mode;
+    SDL_GetSurfaceBlendMode(conv, &mode);
+    SDL_SetSurfaceBlendMode(conv, SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(conv, NULL, page, &dst);
+    if (conv != src)
+        SDL_FreeSurface(conv);
+    else
+        SDL_SetSurfaceBlendMode(src, mode);
+
+    if (padding <= 0)
+        return true;
+
+    if (SDL_LockSurface(page) != 0)
+        return false;
+    Uint32 *px = page->pixels;
+    int stride = page->pitch / (int)sizeof(Uint32);
+
+    // Columnas: izquierda y derecha
+    for (int y = dst.y; y < dst.y + dst.h; y++)
+    {
+        Uint32 *row = px + y * stride;
+        for (int k = 1; k <= padding; k++)
+        {
+            row[dst.x - k]             = row[dst.x];
+            row[dst.x + dst.w - 1 + k] = row[dst.x + dst.w - 1];
+        }
+    }
+
+    // Filas: arriba y abajo (incluye las esquinas ya extruidas)
+    int x0 = dst.x - padding;
+    size_t rowBytes = (size_t)(dst.w + 2 * padding) * sizeof(Uint32);
+    for (int k = 1; k <= padding; k++)
+    {
+        memcpy(px + (dst.y - k) * stride + x0, px + dst.y * stride + x0, rowBytes);
+        memcpy(px + (dst.y + dst.h - 1 + k) * stride + x0, px + (dst.y + dst.h - 1) * stride + x0, rowBytes);
+    }
+    SDL_UnlockSurface(page);
+    return true;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+// Primer formato de 32 bits con alpha que declara el renderer (ARGB8888 si no hay).
+Uint32 Atlas_PixelFormat(void)
+{
+    SDL_RendererInfo info;
+    if (render && SDL_GetRendererInfo(render, &info) == 0)
+    {
+        for (Uint32 i = 0; i < info.num_texture_formats; i++)
+        {
+            Uint32 f = info.texture_formats[i];
+            if (SDL_ISPIXELFORMAT_ALPHA(f) && SDL_BYTESPERPIXEL(f) == 4)
+                return f;
+        }
+    }
+    return SDL_PIXELFORMAT_ARGB8888;
+}
+
+// Empaqueta todo primero (solo rects) y despues compone y sube cada pagina.
+int Atlas_Build(SDL_Surface **surfaces, int count, int pageSize, int padding,
+                SDL_Texture ***outPages, int *pageOf, SDL_Rect *rects)
+{
+    *outPages = NULL;
+    if (!surfaces || count <= 0 || !pageOf || !rects)
+        return 0;
+    if (padding < 0)
+        padding = 0;
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(render, &info) == 0)
+    {
+        if (info.max_texture_width > 0 && pageSize > info.max_texture_width)
+            pageSize = info.max_texture_width;
+        if (info.max_texture_height > 0 && pageSize > info.max_texture_height)
+            pageSize = info.max_texture_height;
+    }
+
+    PackItem *items = malloc((size_t)count * sizeof(PackItem));
+    AtlasPage *pages = NULL;
+    int pageCount = 0;
+    bool failed = false;
+    if (!items)
+    {
+        printDebug(LOG_ERROR, "Atlas: sin memoria para %d imagenes\n", count);
+        return 0;
+    }
+
+    int itemCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        pageOf[i] = -1;
+        rects[i]  = (SDL_Rect){0};
+        if (surfaces[i])
+            items[itemCount++] = (PackItem){i, surfaces[i]->w + 2 * padding, surfaces[i]->h + 2 * padding};
+    }
+    qsort(items, (size_t)itemCount, sizeof(PackItem), compareItems);
+
+    // 1) Empaquetar: primera pagina donde entre, si no una nueva
+    for (int k = 0; k < itemCount; k++)
+    {
+        PackItem *it = &items[k];
+        int x = 0, y = 0, p = 0;
+        while (p < pageCount && !skylineInsert(&pages[p], it->w, it->h, &x, &y))
+            p++;
+
+        if (p == pageCount)
+        {
+            AtlasPage *grown = realloc(pages, (size_t)(pageCount + 1) * sizeof(AtlasPage));
+            if (!grown)
+            {
+                failed = true;
+                break;
+            }
+            pages = grown;
+            if (!pageInit(&pages[p], it->w > pageSize ? it->w : pageSize, it->h > pageSize ? it->h : pageSize))
+            {
+                failed = true;
+                break;
+            }
+            pageCount++;
+            skylineInsert(&pages[p], it->w, it->h, &x, &y);
+        }
+
+        pageOf[it->index] = p;
+        rects[it->index]  = (SDL_Rect){x + padding, y + padding, it->w - 2 * padding, it->h - 2 * padding};
+    }
+    free(items);
+
+    if (failed)
+        printDebug(LOG_ERROR, "Atlas: sin memoria para una pagina nueva\n");
+
+    // 2) Componer cada pagina en el formato nativo del renderer y subirla
+    if (pageCount > 0 && !failed)
+        *outPages = calloc((size_t)pageCount, sizeof(SDL_Texture *));
+    Uint32 format = Atlas_PixelFormat();
+    double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    int created = 0;
+    for (int p = 0; p < pageCount && *outPages; p++, created++)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        SDL_Surface *canvas = SDL_CreateRGBSurfaceWithFormat(0, pages[p].usedW, pages[p].usedH, 32, format);
+        if (!canvas)
+            break;
+        for (int i = 0; i < count; i++)
+        {
+            if (pageOf[i] == p && !blitExtruded(canvas, surfaces[i], rects[i], padding))
+                printDebug(LOG_WARN, "Atlas: no se pudo copiar la imagen %d: %s\n", i, SDL_GetError());
+        }
+        Uint64 composed = SDL_GetPerformanceCounter();
+        (*outPages)[p] = SDL_CreateTextureFromSurface(render, canvas);
+        SDL_FreeSurface(canvas);
+        if (!(*outPages)[p])
+            break;
+        printDebug(LOG_INFO, "Atlas: pagina %d de %dx%d (composicion %.2f ms, subida %.2f ms)\n", p,
+                   pages[p].usedW, pages[p].usedH, (double)(composed - start) * msPerTick,
+                   (double)(SDL_GetPerformanceCounter() - composed) * msPerTick);
+    }
+
+    for (int p = 0; p < pageCount; p++)
+        free(pages[p].nodes);
+    free(pages);
+
+    if (failed || pageCount == 0 || created < pageCount)
+    {
+        printDebug(LOG_ERROR, "Atlas: no se pudieron crear las paginas: %s\n", SDL_GetError());
+        Atlas_FreePages(*outPages, pageCount);
+        *outPages = NULL;
+        return 0;
+    }
+    return pageCount;
+}
+
+// Destruye las texturas de las paginas y libera el array.
+void Atlas_FreePages(SDL_Texture **pages, int pageCount)
+{
+    if (!pages)
+        return;
+    for (int p = 0; p < pageCount; p++)
+    {
+        if (pages[p])
+            SDL_DestroyTexture(pages[p]);
+    }
+    free(pages);
+}
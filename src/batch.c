@@ -0,0 +1,338 @@
+/**
+ * @file batch.c
+ * @brief Implementacion del batching de sprites con SDL_RenderGeometry.
+ *
+ * Cada textura (+ blend mode) tiene un bucket con su buffer de vertices.
+ * Los indices siguen siempre el mismo patron (dos triangulos por quad),
+ * asi que se comparte un unico buffer de indices entre todos los buckets.
+ * Los buffers se reutilizan entre frames: solo crecen, nunca se liberan
+ * hasta SpriteBatch_Destroy().
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "batch.h"
+#include "camera.h"
+#include "engine.h"
+#include "tools.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define BATCH_MIN_QUADS 64
+#define BATCH_DEG_TO_RAD (3.14159265358979323846 / 180.0)
+
+typedef struct {
+    SDL_Texture  *texture;    // Textura del grupo
+    SDL_BlendMode blend;      // Blend mode de la textura al crear el grupo
+    float         inv_w;      // 1 / ancho de la textura (para UVs)
+    float         inv_h;      // 1 / alto de la textura
+    SDL_Vertex   *vertices;   // 4 vertices por quad
+    int           quad_count; // Quads encolados en este frame
+    int           capacity;   // Capacidad de vertices en quads
+} BatchBucket;
+
+static BatchBucket *buckets     = NULL;
+static int bucketCount          = 0; // Buckets en uso en el batch actual
+static int bucketCapacity       = 0; // Buckets reservados (se reutilizan)
+static int lastBucket           = -1; // Cache del ultimo bucket usado
+
+static int *indices             = NULL;
+static int indexQuads           = 0; // Quads cubiertos por el buffer de indices
+
+static bool batching            = false;
+static SpriteBatchStats stats   = {0};
+static SpriteBatchStats pending = {0};
+
+static const SDL_Color white = {255, 255, 255, 255};
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Crece un buffer al doble hasta cubrir 'needed' elementos.
+// Retorna false si no hay memoria (el buffer original queda intacto).
+static bool growBuffer(void **buffer, int *capacity, int needed, size_t elemSize)
+{
+    if (needed <= *capacity)
+        return true;
+
+    int newCap = *capacity > 0 ? *capacity : BATCH_MIN_QUADS;
+    while (newCap < needed)
+        newCap *= 2;
+
+    void *tmp = realloc(*buffer, (size_t)newCap * elemSize);
+    if (!tmp)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para el sprite batch\n");
+        return false;
+    }
+    *buffer = tmp;
+    *capacity = newCap;
+    return true;
+}
+
+// Asegura que el buffer de indices compartido cubra 'quads' quads.
+static bool ensureIndices(int quads)
+{
+    int oldQuads = indexQuads;
+    int cap = indexQuads;
+    if (!growBuffer((void **)&indices, &cap, quads, 6 * sizeof(int)))
+        return false;
+
+    for (int q = oldQuads; q < cap; q++)
+    {
+        int v = q * 4;
+        int *i = &indices[q * 6];
+        i[0] = v;     i[1] = v + 1; i[2] = v + 2;
+        i[3] = v;     i[4] = v + 2; i[5] = v + 3;
+    }
+    indexQuads = cap;
+    return true;
+}
+
+// Busca (o crea) el bucket de una textura + blend mode.
+static BatchBucket *getBucket(SDL_Texture *tex)
+{
+    SDL_BlendMode blend = SDL_BLENDMODE_NONE;
+    SDL_GetTextureBlendMode(tex, &blend);
+
+    if (lastBucket >= 0 && buckets[lastBucket].texture == tex && buckets[lastBucket].blend == blend)
+        return &buckets[lastBucket];
+
+    for (int i = 0; i < bucketCount; i++)
+    {
+        if (buckets[i].texture == tex && buckets[i].blend == blend)
+        {
+            lastBucket = i;
+            return &buckets[i];
+        }
+    }
+
+    if (bucketCount >= bucketCapacity)
+    {
+        int oldCap = bucketCapacity;
+        int newCap = oldCap > 0 ? oldCap * 2 : 8;
+        BatchBucket *tmp = realloc(buckets, (size_t)newCap * sizeof(BatchBucket));
+        if (!tmp)
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para el sprite batch\n");
+            return NULL;
+        }
+        for (int i = oldCap; i < newCap; i++)
+            tmp[i] = (BatchBucket){0};
+        buckets = tmp;
+        bucketCapacity = newCap;
+    }
+
+    int w = 0, h = 0;
+    GetTextureSize(tex, &w, &h);
+    if (w <= 0 || h <= 0)
+        return NULL;
+
+    // Reutiliza el bucket (y su buffer de vertices) de frames anteriores
+    BatchBucket *b = &buckets[bucketCount];
+    b->texture    = tex;
+    b->blend      = blend;
+    b->inv_w      = 1.0f / (float)w;
+    b->inv_h      = 1.0f / (float)h;
+    b->quad_count = 0;
+    lastBucket    = bucketCount++;
+    return b;
+}
+
+// Escribe los 4 vertices (TL, TR, BR, BL) del sprite en 'v'.
+void SpriteBatch_BuildQuad(SDL_Vertex *v, const Sprite *s, float inv_w, float inv_h)
+{
+    float u0 = s->src.x * inv_w;
+    float v0 = s->src.y * inv_h;
+    float u1 = (s->src.x + s->src.w) * inv_w;
+    float v1 = (s->src.y + s->src.h) * inv_h;
+
+    // Camino rapido: sin rotacion ni flip, el quad es el dst tal cual
+    if (s->angle == 0.0 && s->flip == SDL_FLIP_NONE)
+    {
+        float x0 = s->dst.x, y0 = s->dst.y;
+        float x1 = x0 + s->dst.w, y1 = y0 + s->dst.h;
+        v[0] = (SDL_Vertex){{x0, y0}, white, {u0, v0}};
+        v[1] = (SDL_Vertex){{x1, y0}, white, {u1, v0}};
+        v[2] = (SDL_Vertex){{x1, y1}, white, {u1, v1}};
+        v[3] = (SDL_Vertex){{x0, y1}, white, {u0, v1}};
+        return;
+    }
+
+    // El flip intercambia las coordenadas de textura, no la geometria
+    if (s->flip & SDL_FLIP_HORIZONTAL)
+    {
+        float t = u0; u0 = u1; u1 = t;
+    }
+    if (s->flip & SDL_FLIP_VERTICAL)
+    {
+        float t = v0; v0 = v1; v1 = t;
+    }
+
+    // Rotacion horaria alrededor del centro del dst (igual que SDL_RenderCopyExF)
+    float hw = s->dst.w * 0.5f;
+    float hh = s->dst.h * 0.5f;
+    float cx = s->dst.x + hw;
+    float cy = s->dst.y + hh;
+    float rad = (float)(s->angle * BATCH_DEG_TO_RAD);
+    float sn = sinf(rad);
+    float cs = cosf(rad);
+
+    const float ox[4] = {-hw,  hw, hw, -hw};
+    const float oy[4] = {-hh, -hh, hh,  hh};
+    const float us[4] = {u0, u1, u1, u0};
+    const float vs[4] = {v0, v0, v1, v1};
+
+    for (int i = 0; i < 4; i++)
+    {
+        v[i].position.x  = cx + ox[i] * cs - oy[i] * sn;
+        v[i].position.y  = cy + ox[i] * sn + oy[i] * cs;
+        v[i].color       = white;
+        v[i].tex_coord.x = us[i];
+        v[i].tex_coord.y = vs[i];
+    }
+}
+
+// ============================================================
+// API
+// ============================================================
+
+// Abre un batch: vacia los buckets pero conserva su memoria.
+void SpriteBatch_Begin(void)
+{
+    bucketCount = 0;
+    lastBucket  = -1;
+    pending     = (SpriteBatchStats){0};
+    batching    = true;
+}
+
+// Encola un sprite en el bucket de su textura.
+void SpriteBatch_Submit(const Sprite *s)
+{
+    if (!s || !s->texture)
+        return;
+
+    if (!batching)
+    {
+        Sprite_Draw((Sprite *)s);
+        return;
+    }
+
+    Sprite view;
+    if (!Camera_Project(s, &view))
+        return;
+
+    BatchBucket *b = getBucket(s->texture);
+    if (!b)
+        return;
+
+    if (!growBuffer((void **)&b->vertices, &b->capacity, b->quad_count + 1, 4 * sizeof(SDL_Vertex)))
+        return;
+
+    SpriteBatch_BuildQuad(&b->vertices[b->quad_count * 4], &view, b->inv_w, b->inv_h);
+    b->quad_count++;
+    pending.sprites++;
+}
+
+// Encola el sprite base de un sprite animado con el frame de sim_time
+// (en modo por ticks su src ya es el frame actual).
+void SpriteBatch_SubmitAnimated(const AnimatedSprite *as)
+{
+    if (!as)
+        return;
+    Sprite s = as->sprite;
+    s.src = ASprite_FrameAt(as, sim_time);
+    SpriteBatch_Submit(&s);
+}
+
+// Copia quads ya armados (texto, geometria propia) al bucket de su textura.
+void SpriteBatch_SubmitQuads(SDL_Texture *texture, const SDL_Vertex *vertices, int quadCount)
+{
+    if (!texture || !vertices || quadCount <= 0)
+        return;
+
+    if (!batching)
+    {
+        if (ensureIndices(quadCount))
+            SDL_RenderGeometry(render, texture, vertices, quadCount * 4, indices, quadCount * 6);
+        return;
+    }
+
+    BatchBucket *b = getBucket(texture);
+    if (!b)
+        return;
+
+    if (!growBuffer((void **)&b->vertices, &b->capacity, b->quad_count + quadCount, 4 * sizeof(SDL_Vertex)))
+        return;
+
+    memcpy(&b->vertices[b->quad_count * 4], vertices, (size_t)quadCount * 4 * sizeof(SDL_Vertex));
+    b->quad_count += quadCount;
+    pending.sprites += quadCount;
+}
+
+// Dibuja cada bucket con una sola llamada y cierra el batch.
+void SpriteBatch_Flush(void)
+{
+    if (!batching)
+        return;
+    batching = false;
+
+    int maxQuads = 0;
+    for (int i = 0; i < bucketCount; i++)
+    {
+        if (buckets[i].quad_count > maxQuads)
+            maxQuads = buckets[i].quad_count;
+    }
+
+    if (maxQuads > 0 && ensureIndices(maxQuads))
+    {
+        for (int i = 0; i < bucketCount; i++)
+        {
+            BatchBucket *b = &buckets[i];
+            if (b->quad_count <= 0)
+                continue;
+            SDL_RenderGeometry(render, b->texture, b->vertices, b->quad_count * 4,
+                               indices, b->quad_count * 6);
+            pending.draw_calls++;
+        }
+    }
+
+    stats = pending;
+    bucketCount = 0;
+    lastBucket  = -1;
+}
+
+// Buffer de indices compartido (0,1,2, 0,2,3 por quad).
+const int *SpriteBatch_QuadIndices(int quads)
+{
+    return ensureIndices(quads) ? indices : NULL;
+}
+
+// Devuelve los contadores del ultimo flush.
+SpriteBatchStats SpriteBatch_GetStats(void)
+{
+    return stats;
+}
+
+// Libera todos los buffers del batch.
+void SpriteBatch_Destroy(void)
+{
+    for (int i = 0; i < bucketCapacity; i++)
+        free(buckets[i].vertices);
+    free(buckets);
+    free(indices);
+    buckets        = NULL;
+    indices        = NULL;
+    bucketCount    = 0;
+    bucketCapacity = 0;
+    indexQuads     = 0;
+    lastBucket     = -1;
+    batching       = false;
+}
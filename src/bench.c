@@ -0,0 +1,894 @@
+/**
+ * @file bench.c
+ * @brief Implementacion de las escenas de benchmark.
+ *
+ * Con BENCH_MAIN definido, este archivo aporta su propio main():
+ * @code
+ * make bench                      # todas las escenas
+ * make bench ARGS="sprites"       # solo una escena
+ * make bench ARGS="jobs"          # escalado del sistema de jobs
+ * make bench ARGS="text"          # textos de HUD que cambian cada frame
+ * make bench ARGS="ecs"           # 100k entidades animadas en movimiento
+ * make bench ARGS="queue"         # sprites intercalados entre texturas
+ * make bench ARGS="tilemap"       # mapa de tiles grande con scroll
+ * make bench ARGS="camera"        # nivel grande: recorte por camara y grilla
+ * make bench ARGS="dirty"         # escena estatica con pocos sprites en movimiento
+ * make bench ARGS="mixer"         # mezclador de audio por software (voces y kernels)
+ * make bench ARGS="--software"    # forzar el renderer por software
+ * @endcode
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "bench.h"
+#include "batch.h"
+#include "camera.h"
+#include "config.h"
+#include "ecs.h"
+#include "engine.h"
+#include "img.h"
+#include "jobs.h"
+#include "mixer.h"
+#include "renderqueue.h"
+#include "spatial.h"
+#include "sprites.h"
+#include "text.h"
+#include "tilemap.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define BENCH_FRAMES 60   // Frames medidos por caso
+#define BENCH_SEED   1234 // Semilla fija para que las escenas sean reproducibles
+#define BENCH_ANIMS  100000 // Sprites animados en la escena de jobs
+#define BENCH_ITERS  64     // Pasos del kernel de calculo por elemento
+#define BENCH_TEXTS  500    // Textos de HUD en la escena de texto
+#define BENCH_CLIPS  20     // Clips compartidos (velocidades distintas) en las escenas animadas
+#define BENCH_QUEUE_TEXTURES 8 // Texturas intercaladas en la escena de la cola de render
+#define BENCH_MAP_SIZE 128     // Celdas por lado del mapa de la escena de tilemap
+#define BENCH_WORLD    16384.0f // Lado del nivel de la escena de camara (pixeles de mundo)
+#define BENCH_STATIC   2000     // Sprites quietos en la escena de dirty rects
+#define BENCH_MIX_RATE   44100  // Frames por segundo de audio en la escena del mezclador
+#define BENCH_MIX_BUFFER 2048   // Frames por callback (igual que initAudio)
+
+typedef enum {
+    CULL_NONE, // Todos los sprites al batch (la camara descarta al proyectar)
+    CULL_GRID  // Solo los que devuelve la grilla para la vista
+} CullMode;
+
+typedef enum {
+    MAP_TILES,  // Un quad por tile visible (sin chunks)
+    MAP_CHUNKS, // Chunks horneados, mapa estatico
+    MAP_EDITS   // Chunks horneados, un tile cambia cada frame
+} MapMode;
+
+typedef enum {
+    TEXT_TTF,   // Rasterizar + subir + destruir una textura por string (camino anterior)
+    TEXT_ATLAS, // Text_Set + Text_Draw (una llamada por texto)
+    TEXT_BATCH, // Igual, dentro de un SpriteBatch (una llamada por pagina)
+    TEXT_NUMBER // Solo los numeros con NumberText, dentro de un SpriteBatch
+} TextMode;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Milisegundos transcurridos desde 'start' (contador de alta resolucion).
+static double elapsedMs(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// Llena 'sprites' con regiones de 16x16 repartidas entre las imagenes de la libreria.
+static void scatterSprites(Sprite *sprites, int n, texture *lib, bool rotated)
+{
+    srand(BENCH_SEED);
+    for (int i = 0; i < n; i++)
+    {
+        TextureRegion region = getTextureRegion(lib, i % lib->n);
+        SDL_Rect src = {region.src.x, region.src.y, 16, 16};
+        float x = (float)(rand() % (config.WIN_W > 16 ? config.WIN_W - 16 : 1));
+        float y = (float)(rand() % (config.WIN_H > 16 ? config.WIN_H - 16 : 1));
+        sprites[i] = Sprite_Create(region.texture, src, x, y);
+        if (rotated)
+        {
+            sprites[i].angle = (double)(i % 360);
+            sprites[i].flip  = (i & 1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_VERTICAL;
+        }
+    }
+}
+
+// Dibuja BENCH_FRAMES frames y devuelve el promedio en ms por frame.
+static double runSpriteFrames(Sprite *sprites, int n, bool batched, int *drawCalls)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        if (batched)
+        {
+            SpriteBatch_Begin();
+            for (int i = 0; i < n; i++)
+                SpriteBatch_Submit(&sprites[i]);
+            SpriteBatch_Flush();
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+                Sprite_Draw(&sprites[i]);
+        }
+        SDL_RenderPresent(render);
+    }
+    *drawCalls = batched ? SpriteBatch_GetStats().draw_calls : n;
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Igual que runSpriteFrames pero a traves de la cola de render, en una sola capa.
+static double runQueueFrames(Sprite *sprites, int n, RenderQueueStats *queueStats)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        RenderQueue_Begin();
+        for (int i = 0; i < n; i++)
+            RenderQueue_Sprite(&sprites[i], RENDER_LAYER_WORLD, 0);
+        RenderQueue_Flush();
+        SDL_RenderPresent(render);
+    }
+    *queueStats = RenderQueue_GetStats();
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Scroll diagonal sobre el mapa; acumula copias, draw calls y chunks horneados por frame.
+static double runMapFrames(Tilemap *map, MapMode mode, double *copies, double *calls, double *bakes)
+{
+    *copies = *calls = *bakes = 0.0;
+    float maxX = (float)(map->width * map->tile_w - config.WIN_W);
+    float maxY = (float)(map->height * map->tile_h - config.WIN_H);
+    Camera cam = Camera_Create();
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        cam.x = fmodf((float)f * 7.0f, maxX > 1.0f ? maxX : 1.0f);
+        cam.y = fmodf((float)f * 5.0f, maxY > 1.0f ? maxY : 1.0f);
+        if (mode == MAP_EDITS)
+        {
+            int tx = (int)(cam.x + (float)config.WIN_W / 2) / map->tile_w;
+            int ty = (int)(cam.y + (float)config.WIN_H / 2) / map->tile_h;
+            Tilemap_Set(map, tx, ty, (Uint16)(f % map->tileset_count));
+        }
+
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        Camera_SetActive(&cam);
+        RenderQueue_Begin();
+        *copies += mode == MAP_TILES ? Tilemap_DrawTiles(map, RENDER_LAYER_BACKGROUND)
+                                     : Tilemap_Draw(map, RENDER_LAYER_BACKGROUND);
+        RenderQueue_Flush();
+        Camera_SetActive(NULL);
+        SDL_RenderPresent(render);
+        *calls += RenderQueue_GetStats().draw_calls;
+        *bakes += map->last_bakes;
+    }
+    *copies /= BENCH_FRAMES;
+    *calls  /= BENCH_FRAMES;
+    *bakes  /= BENCH_FRAMES;
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Recorre el nivel con la camara; acumula sprites enviados por frame.
+static double runCullFrames(Sprite *sprites, int n, SpatialGrid *grid, int *visible, CullMode mode, double *submitted)
+{
+    Camera cam = Camera_Create();
+    *submitted = 0.0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        Camera_CenterOn(&cam, BENCH_WORLD * 0.5f + (float)f * 40.0f, BENCH_WORLD * 0.5f + (float)f * 25.0f);
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        Camera_SetActive(&cam);
+        SpriteBatch_Begin();
+        if (mode == CULL_GRID)
+        {
+            int count = Spatial_Query(grid, Camera_View(&cam), visible, n);
+            for (int i = 0; i < count; i++)
+                SpriteBatch_Submit(&sprites[visible[i]]);
+            *submitted += count;
+        }
+        else
+        {
+            for (int i = 0; i < n; i++)
+                SpriteBatch_Submit(&sprites[i]);
+            *submitted += n;
+        }
+        SpriteBatch_Flush();
+        Camera_SetActive(NULL);
+        SDL_RenderPresent(render);
+    }
+    *submitted /= BENCH_FRAMES;
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Fondo + sprites quietos + 'moving' sprites que se desplazan; redibujo completo o dirty rects.
+static double runDirtyFrames(Sprite *sprites, int n, int moving, bool dirtyRects, double *redrawn)
+{
+    *redrawn = 0.0;
+    RenderQueue_SetDirtyRects(dirtyRects);
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        for (int i = 1; i <= moving && i < n; i++)
+            sprites[i].dst.x = (float)((int)(sprites[i].dst.x + 2.0f) % (config.WIN_W > 16 ? config.WIN_W - 16 : 1));
+
+        if (!dirtyRects)
+        {
+            SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+            SDL_RenderClear(render);
+        }
+        RenderQueue_Begin();
+        RenderQueue_Sprite(&sprites[0], RENDER_LAYER_BACKGROUND, 0);
+        for (int i = 1; i < n; i++)
+            RenderQueue_Sprite(&sprites[i], RENDER_LAYER_WORLD, (Uint32)i);
+        RenderQueue_Flush();
+        SDL_RenderPresent(render);
+        *redrawn += RenderQueue_GetStats().redrawn_pct;
+    }
+    RenderQueue_SetDirtyRects(false);
+    *redrawn /= BENCH_FRAMES;
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Kernel de calculo puro (simula una pasada de IA/colision por entidad).
+static void computeRange(int start, int end, void *data)
+{
+    float *values = data;
+    for (int i = start; i < end; i++)
+    {
+        float x = values[i];
+        for (int k = 0; k < BENCH_ITERS; k++)
+            x = x * 0.999f + sinf(x) * 0.001f;
+        values[i] = x;
+    }
+}
+
+// Promedio en ms de BENCH_FRAMES pasadas de animacion o de calculo.
+static double runJobFrames(AnimatedSprite *anims, float *values, bool compute)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        if (compute)
+            Jobs_ParallelFor(BENCH_ANIMS, 256, computeRange, values);
+        else
+            ASprite_UpdateMany(anims, BENCH_ANIMS, 1.0f / 60.0f);
+    }
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Promedio en ms de BENCH_FRAMES frames donde todos los textos cambian.
+static double runTextFrames(Text *texts, NumberText *numbers, TextMode mode, int *drawCalls)
+{
+    char buffer[64];
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int f = 0; f < BENCH_FRAMES; f++)
+    {
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        if (mode == TEXT_BATCH || mode == TEXT_NUMBER)
+            SpriteBatch_Begin();
+        for (int i = 0; i < BENCH_TEXTS; i++)
+        {
+            if (mode == TEXT_NUMBER)
+            {
+                NumberText_Set(&numbers[i * 2], i * 37 + f);
+                NumberText_SetTime(&numbers[i * 2 + 1], f);
+                NumberText_Draw(&numbers[i * 2]);
+                NumberText_Draw(&numbers[i * 2 + 1]);
+                continue;
+            }
+            snprintf(buffer, sizeof(buffer), "SCORE %06d  T %02d:%02d", i * 37 + f, f / 60, f % 60);
+            if (mode == TEXT_TTF)
+            {
+                SDL_Surface *srf = TTF_RenderUTF8_Blended(texts[i].font->ttf, buffer, texts[i].color);
+                SDL_Texture *tex = srf ? SDL_CreateTextureFromSurface(render, srf) : NULL;
+                if (tex)
+                {
+                    SDL_Rect dst = {texts[i].rect.x, texts[i].rect.y, srf->w, srf->h};
+                    SDL_RenderCopy(render, tex, NULL, &dst);
+                    SDL_DestroyTexture(tex);
+                }
+                SDL_FreeSurface(srf);
+            }
+            else
+            {
+                Text_Set(&texts[i], buffer);
+                Text_Draw(&texts[i]);
+            }
+        }
+        if (mode == TEXT_BATCH || mode == TEXT_NUMBER)
+            SpriteBatch_Flush();
+        SDL_RenderPresent(render);
+    }
+    *drawCalls = mode == TEXT_BATCH || mode == TEXT_NUMBER ? SpriteBatch_GetStats().draw_calls : BENCH_TEXTS;
+    return elapsedMs(start) / BENCH_FRAMES;
+}
+
+// Sistema de la escena ECS: rebota contra los bordes de la ventana.
+static void bounceRange(EcsWorld *w, int start, int end, void *data)
+{
+    (void)data;
+    float maxX = (float)config.WIN_W - 16.0f;
+    float maxY = (float)config.WIN_H - 16.0f;
+    for (int i = start; i < end; i++)
+    {
+        if ((w->x[i] < 0.0f && w->vx[i] < 0.0f) || (w->x[i] > maxX && w->vx[i] > 0.0f))
+            w->vx[i] = -w->vx[i];
+        if ((w->y[i] < 0.0f && w->vy[i] < 0.0f) || (w->y[i] > maxY && w->vy[i] > 0.0f))
+            w->vy[i] = -w->vy[i];
+    }
+}
+
+// ============================================================
+// Escenas
+// ============================================================
+
+// Inmediato vs batch (camino rapido) vs batch con rotacion/flip.
+void Bench_SpriteBatch(void)
+{
+    static const int counts[] = {1000, 10000, 50000};
+
+    texture lib = initTextureLib(SPRITES_DIR);
+    if (lib.n <= 0)
+    {
+        printDebug(LOG_ERROR, "Bench sprites: no hay texturas en '%s'\n", SPRITES_DIR);
+        return;
+    }
+
+    printf("\n=== Sprite batch (%d imagenes en %d paginas, %d frames por caso) ===\n", lib.n, lib.page_count, BENCH_FRAMES);
+    printf("%8s  %-18s  %10s  %10s\n", "sprites", "modo", "ms/frame", "draw calls");
+
+    for (int c = 0; c < (int)ARRAY_L(counts); c++)
+    {
+        int n = counts[c];
+        Sprite *sprites = malloc((size_t)n * sizeof(Sprite));
+        if (!sprites)
+        {
+            printDebug(LOG_ERROR, "Bench sprites: sin memoria para %d sprites\n", n);
+            break;
+        }
+
+        int calls = 0;
+        double ms;
+
+        scatterSprites(sprites, n, &lib, false);
+        ms = runSpriteFrames(sprites, n, false, &calls);
+        printf("%8d  %-18s  %10.3f  %10d\n", n, "inmediato", ms, calls);
+        ms = runSpriteFrames(sprites, n, true, &calls);
+        printf("%8d  %-18s  %10.3f  %10d\n", n, "batch", ms, calls);
+
+        scatterSprites(sprites, n, &lib, true);
+        ms = runSpriteFrames(sprites, n, false, &calls);
+        printf("%8d  %-18s  %10.3f  %10d\n", n, "inmediato rot/flip", ms, calls);
+        ms = runSpriteFrames(sprites, n, true, &calls);
+        printf("%8d  %-18s  %10.3f  %10d\n", n, "batch rot/flip", ms, calls);
+
+        free(sprites);
+    }
+
+    freeTextureLib(&lib);
+}
+
+// Escalado de Jobs_ParallelFor de 1 a N workers (animacion y calculo).
+void Bench_Jobs(void)
+{
+    int maxWorkers = SDL_GetCPUCount() > 1 ? SDL_GetCPUCount() : 1;
+    AnimatedSprite *anims = calloc(BENCH_ANIMS, sizeof(AnimatedSprite));
+    float *values = malloc(BENCH_ANIMS * sizeof(float));
+    if (!anims || !values)
+    {
+        printDebug(LOG_ERROR, "Bench jobs: sin memoria para %d elementos\n", BENCH_ANIMS);
+        free(anims);
+        free(values);
+        return;
+    }
+
+    // Pocos clips compartidos por todas las instancias (velocidades de 5 a 24 fps)
+    int clips[BENCH_CLIPS];
+    for (int c = 0; c < BENCH_CLIPS; c++)
+    {
+        Animation eat = Anim_CreateFromSheet(16, 16, 3, 0, 3, 5.0f + (float)c, true);
+        clips[c] = Clip_FromAnimation(&eat);
+        Anim_Free(&eat);
+    }
+
+    srand(BENCH_SEED);
+    for (int i = 0; i < BENCH_ANIMS; i++)
+    {
+        anims[i] = ASprite_Create(NULL, clips[rand() % BENCH_CLIPS], 0.0f, 0.0f);
+        values[i] = (float)(rand() % 1000) / 100.0f;
+    }
+
+    printf("\n=== Jobs (%d elementos, %d frames por caso, %d nucleos) ===\n", BENCH_ANIMS, BENCH_FRAMES, maxWorkers);
+    printf("%8s  %-10s  %10s  %8s\n", "workers", "pasada", "ms/frame", "speedup");
+
+    double baseAnim = 0.0, baseCompute = 0.0;
+    // 1, 2, 4, ... y siempre el total de nucleos al final
+    for (int t = 1; ; t = t * 2 < maxWorkers ? t * 2 : maxWorkers)
+    {
+        if (!Jobs_Init(t))
+            break;
+
+        double anim = runJobFrames(anims, values, false);
+        double compute = runJobFrames(anims, values, true);
+        if (t == 1)
+        {
+            baseAnim = anim;
+            baseCompute = compute;
+        }
+        printf("%8d  %-10s  %10.3f  %7.2fx\n", t, "animacion", anim, baseAnim / anim);
+        printf("%8d  %-10s  %10.3f  %7.2fx\n", t, "calculo", compute, baseCompute / compute);
+
+        if (t >= maxWorkers)
+            break;
+    }
+
+    // Dejar el sistema como lo configura Game_Init
+    Jobs_Init(0);
+
+    for (int i = 0; i < BENCH_ANIMS; i++)
+        ASprite_Free(&anims[i]);
+    free(anims);
+    free(values);
+}
+
+// Textos de HUD que cambian cada frame: TTF por string vs atlas de glyphs.
+void Bench_Text(void)
+{
+    static const struct { TextMode mode; const char *name; } modes[] = {
+        {TEXT_TTF,   "ttf por string"},
+        {TEXT_ATLAS, "atlas"},
+        {TEXT_BATCH, "atlas + batch"},
+        {TEXT_NUMBER, "numeros + batch"},
+    };
+
+    Text *texts = calloc(BENCH_TEXTS, sizeof(Text));
+    NumberText *numbers = calloc(BENCH_TEXTS * 2, sizeof(NumberText));
+    if (!texts || !numbers)
+    {
+        printDebug(LOG_ERROR, "Bench texto: sin memoria para %d textos\n", BENCH_TEXTS);
+        free(texts);
+        free(numbers);
+        return;
+    }
+
+    srand(BENCH_SEED);
+    for (int i = 0; i < BENCH_TEXTS; i++)
+    {
+        SDL_Color color = {(Uint8)(128 + rand() % 128), (Uint8)(128 + rand() % 128), 255, 255};
+        texts[i] = Text_CreateColored("", rand() % (config.WIN_W > 200 ? config.WIN_W - 200 : 1),
+                                      rand() % (config.WIN_H > 24 ? config.WIN_H - 24 : 1), color);
+        // Puntaje de 6 cifras y timer MM:SS en el lugar del texto
+        numbers[i * 2] = NumberText_Create(NULL, texts[i].rect.x, texts[i].rect.y, 6, NUMBER_LEADING_ZEROS);
+        numbers[i * 2 + 1] = NumberText_Create(NULL, texts[i].rect.x + 7 * numbers[i * 2].cell_w, texts[i].rect.y,
+                                               5, NUMBER_LEADING_ZEROS);
+        numbers[i * 2].color = numbers[i * 2 + 1].color = color;
+    }
+
+    printf("\n=== Texto (%d strings distintos por frame, %d frames por caso) ===\n", BENCH_TEXTS, BENCH_FRAMES);
+    printf("%-16s  %10s  %10s\n", "modo", "ms/frame", "draw calls");
+    for (int m = 0; m < (int)ARRAY_L(modes); m++)
+    {
+        int calls = 0;
+        double ms = runTextFrames(texts, numbers, modes[m].mode, &calls);
+        printf("%-16s  %10.3f  %10d\n", modes[m].name, ms, calls);
+    }
+
+    for (int i = 0; i < BENCH_TEXTS; i++)
+        Text_Free(&texts[i]);
+    free(texts);
+    free(numbers);
+}
+
+// Entidades que se mueven, rebotan y se animan: update (paralelo) y dibujo por separado.
+void Bench_Ecs(void)
+{
+    static const int counts[] = {10000, 50000, 100000};
+
+    texture lib = initTextureLib(SPRITES_DIR);
+    int sheet = findTexture(&lib, "general_sheet(Corrected 16x16px).png");
+    if (lib.n <= 0)
+    {
+        printDebug(LOG_ERROR, "Bench ecs: no hay texturas en '%s'\n", SPRITES_DIR);
+        return;
+    }
+    TextureRegion region = getTextureRegion(&lib, sheet >= 0 ? sheet : 0);
+
+    int clips[BENCH_CLIPS];
+    for (int c = 0; c < BENCH_CLIPS; c++)
+    {
+        Animation eat = Anim_CreateFromSheet(16, 16, 3, 0, 3, 5.0f + (float)c, true);
+        Anim_Offset(&eat, region.src.x, region.src.y);
+        clips[c] = Clip_FromAnimation(&eat);
+        Anim_Free(&eat);
+    }
+
+    printf("\n=== ECS (%d frames por caso, %d workers) ===\n", BENCH_FRAMES, Jobs_WorkerCount());
+    printf("%8s  %10s  %10s  %10s  %8s\n", "entidades", "update ms", "draw ms", "frame ms", "fps");
+
+    const float dt = 1.0f / 60.0f;
+    for (int c = 0; c < (int)ARRAY_L(counts); c++)
+    {
+        EcsWorld world;
+        if (!Ecs_Init(&world, counts[c]))
+            break;
+
+        srand(BENCH_SEED);
+        for (int i = 0; i < counts[c]; i++)
+        {
+            Entity e = Ecs_Create(&world, (float)(rand() % (config.WIN_W > 16 ? config.WIN_W - 16 : 1)),
+                                  (float)(rand() % (config.WIN_H > 16 ? config.WIN_H - 16 : 1)));
+            Ecs_SetVelocity(&world, e, (float)(rand() % 200 - 100), (float)(rand() % 200 - 100));
+            Ecs_SetSprite(&world, e, region);
+            Ecs_SetAnim(&world, e, clips[rand() % BENCH_CLIPS], 0.0);
+        }
+
+        double updateMs = 0.0, drawMs = 0.0;
+        for (int f = 0; f < BENCH_FRAMES; f++)
+        {
+            Uint64 start = SDL_GetPerformanceCounter();
+            Ecs_Move(&world, dt);
+            Ecs_Run(&world, bounceRange, NULL, 1024);
+            updateMs += elapsedMs(start);
+
+            start = SDL_GetPerformanceCounter();
+            SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+            SDL_RenderClear(render);
+            SpriteBatch_Begin();
+            Ecs_Draw(&world, 1.0f, (double)f * dt);
+            SpriteBatch_Flush();
+            SDL_RenderPresent(render);
+            drawMs += elapsedMs(start);
+        }
+
+        double frameMs = (updateMs + drawMs) / BENCH_FRAMES;
+        printf("%8d  %10.3f  %10.3f  %10.3f  %8.1f\n", counts[c], updateMs / BENCH_FRAMES,
+               drawMs / BENCH_FRAMES, frameMs, frameMs > 0.0 ? 1000.0 / frameMs : 0.0);
+        Ecs_Free(&world);
+    }
+
+    freeTextureLib(&lib);
+}
+
+// Peor caso para el batch: cada sprite usa una textura distinta a la del anterior.
+void Bench_Queue(void)
+{
+    static const int counts[] = {1000, 10000, 50000};
+
+    // Texturas chicas de colores (sin depender de los assets)
+    SDL_Texture *textures[BENCH_QUEUE_TEXTURES] = {0};
+    Uint32 pixels[16 * 16];
+    for (int t = 0; t < BENCH_QUEUE_TEXTURES; t++)
+    {
+        textures[t] = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 16, 16);
+        if (!textures[t])
+        {
+            printDebug(LOG_ERROR, "Bench queue: no se pudo crear la textura %d: %s\n", t, SDL_GetError());
+            for (int k = 0; k < t; k++)
+                SDL_DestroyTexture(textures[k]);
+            return;
+        }
+        Uint32 color = 0xFF000000u | ((Uint32)(t * 97 % 256) << 16) | ((Uint32)(t * 53 % 256) << 8) | (Uint32)(255 - t * 31);
+        for (int p = 0; p < 16 * 16; p++)
+            pixels[p] = color;
+        SDL_UpdateTexture(textures[t], NULL, pixels, 16 * (int)sizeof(Uint32));
+        SDL_SetTextureBlendMode(textures[t], SDL_BLENDMODE_BLEND);
+    }
+
+    printf("\n=== Cola de render (%d texturas intercaladas, %d frames por caso) ===\n", BENCH_QUEUE_TEXTURES, BENCH_FRAMES);
+    printf("%8s  %-10s  %10s  %10s  %12s  %10s\n", "sprites", "modo", "ms/frame", "draw calls", "tex switches", "sort ms");
+
+    for (int c = 0; c < (int)ARRAY_L(counts); c++)
+    {
+        int n = counts[c];
+        Sprite *sprites = malloc((size_t)n * sizeof(Sprite));
+        if (!sprites)
+        {
+            printDebug(LOG_ERROR, "Bench queue: sin memoria para %d sprites\n", n);
+            break;
+        }
+
+        srand(BENCH_SEED);
+        for (int i = 0; i < n; i++)
+        {
+            float x = (float)(rand() % (config.WIN_W > 16 ? config.WIN_W - 16 : 1));
+            float y = (float)(rand() % (config.WIN_H > 16 ? config.WIN_H - 16 : 1));
+            sprites[i] = Sprite_Create(textures[i % BENCH_QUEUE_TEXTURES], (SDL_Rect){0, 0, 16, 16}, x, y);
+        }
+
+        int calls = 0;
+        double ms;
+        RenderQueueStats queue;
+
+        ms = runSpriteFrames(sprites, n, false, &calls);
+        printf("%8d  %-10s  %10.3f  %10d  %12d  %10s\n", n, "inmediato", ms, calls, n - 1, "-");
+        ms = runSpriteFrames(sprites, n, true, &calls);
+        printf("%8d  %-10s  %10.3f  %10d  %12d  %10s\n", n, "batch", ms, calls, calls - 1, "-");
+        ms = runQueueFrames(sprites, n, &queue);
+        printf("%8d  %-10s  %10.3f  %10d  %12d  %10.3f\n", n, "cola", ms, queue.draw_calls, queue.texture_switches, queue.sort_ms);
+
+        free(sprites);
+    }
+
+    for (int t = 0; t < BENCH_QUEUE_TEXTURES; t++)
+        SDL_DestroyTexture(textures[t]);
+}
+
+// Mapa grande de DungeonTile con scroll: un quad por tile vs chunks horneados.
+void Bench_Tilemap(void)
+{
+    static const char *modes[] = {"por tile", "chunks", "chunks + edicion"};
+
+    texture lib = initTextureLib(SPRITES_DIR);
+    int dungeon = findTexture(&lib, "DungeonTile.png");
+    if (dungeon < 0)
+    {
+        printDebug(LOG_ERROR, "Bench tilemap: no se encontro DungeonTile.png en '%s'\n", SPRITES_DIR);
+        freeTextureLib(&lib);
+        return;
+    }
+
+    Tilemap map;
+    if (!Tilemap_Create(&map, BENCH_MAP_SIZE, BENCH_MAP_SIZE, 16, 16, getTextureRegion(&lib, dungeon)))
+    {
+        freeTextureLib(&lib);
+        return;
+    }
+    srand(BENCH_SEED);
+    for (int ty = 0; ty < map.height; ty++)
+        for (int tx = 0; tx < map.width; tx++)
+            Tilemap_Set(&map, tx, ty, (Uint16)(rand() % map.tileset_count));
+
+    printf("\n=== Tilemap (%dx%d celdas, chunks de %dx%d, %d frames por caso) ===\n",
+           map.width, map.height, map.chunk_cols, map.chunk_rows, BENCH_FRAMES);
+    printf("%-18s  %10s  %10s  %10s  %10s\n", "modo", "ms/frame", "copias", "draw calls", "horneados");
+
+    Uint64 bakeStart = SDL_GetPerformanceCounter();
+    int prebaked = Tilemap_Bake(&map);
+    printf("%-18s  %10.3f  %10s  %10s  %10d\n", "precarga", elapsedMs(bakeStart), "-", "-", prebaked);
+
+    for (int m = MAP_TILES; m <= MAP_EDITS; m++)
+    {
+        double copies, calls, bakes;
+        double ms = runMapFrames(&map, (MapMode)m, &copies, &calls, &bakes);
+        printf("%-18s  %10.3f  %10.1f  %10.1f  %10.2f\n", modes[m], ms, copies, calls, bakes);
+    }
+
+    Tilemap_Free(&map);
+    freeTextureLib(&lib);
+}
+
+// Nivel grande con sprites estaticos: enviar todo vs consultar la grilla.
+void Bench_Camera(void)
+{
+    static const int counts[] = {10000, 100000, 200000};
+
+    texture lib = initTextureLib(SPRITES_DIR);
+    if (lib.n <= 0)
+    {
+        printDebug(LOG_ERROR, "Bench camera: no hay texturas en '%s'\n", SPRITES_DIR);
+        return;
+    }
+
+    printf("\n=== Camara y grilla (nivel de %.0fx%.0f, %d frames por caso) ===\n", BENCH_WORLD, BENCH_WORLD, BENCH_FRAMES);
+    printf("%8s  %-10s  %10s  %10s  %10s\n", "sprites", "modo", "ms/frame", "enviados", "visibles");
+
+    for (int c = 0; c < (int)ARRAY_L(counts); c++)
+    {
+        int n = counts[c];
+        Sprite *sprites = malloc((size_t)n * sizeof(Sprite));
+        int *visible = malloc((size_t)n * sizeof(int));
+        SpatialGrid grid;
+        if (!sprites || !visible || !Spatial_Init(&grid, (SDL_FRect){0.0f, 0.0f, BENCH_WORLD, BENCH_WORLD}, 256.0f))
+        {
+            printDebug(LOG_ERROR, "Bench camera: sin memoria para %d sprites\n", n);
+            free(sprites);
+            free(visible);
+            break;
+        }
+
+        srand(BENCH_SEED);
+        for (int i = 0; i < n; i++)
+        {
+            TextureRegion region = getTextureRegion(&lib, i % lib.n);
+            SDL_Rect src = {region.src.x, region.src.y, 16, 16};
+            sprites[i] = Sprite_Create(region.texture, src, (float)(rand() % (int)BENCH_WORLD), (float)(rand() % (int)BENCH_WORLD));
+            Spatial_Insert(&grid, i, sprites[i].dst);
+        }
+
+        double sent;
+        double ms = runCullFrames(sprites, n, &grid, visible, CULL_NONE, &sent);
+        int onScreen = SpriteBatch_GetStats().sprites;
+        printf("%8d  %-10s  %10.3f  %10.0f  %10d\n", n, "todos", ms, sent, onScreen);
+        ms = runCullFrames(sprites, n, &grid, visible, CULL_GRID, &sent);
+        printf("%8d  %-10s  %10.3f  %10.0f  %10d\n", n, "grilla", ms, sent, SpriteBatch_GetStats().sprites);
+
+        Spatial_Free(&grid);
+        free(visible);
+        free(sprites);
+    }
+
+    freeTextureLib(&lib);
+}
+
+// Escena mayormente estatica: redibujar todo vs solo las regiones que cambiaron.
+void Bench_Dirty(void)
+{
+    static const int movingCounts[] = {1, 10, 100};
+
+    texture lib = initTextureLib(SPRITES_DIR);
+    int maze = findTexture(&lib, "Laberinto_224x248.png");
+    if (lib.n <= 0)
+    {
+        printDebug(LOG_ERROR, "Bench dirty: no hay texturas en '%s'\n", SPRITES_DIR);
+        return;
+    }
+
+    int n = BENCH_STATIC + 1;
+    Sprite *sprites = malloc((size_t)n * sizeof(Sprite));
+    if (!sprites)
+    {
+        printDebug(LOG_ERROR, "Bench dirty: sin memoria para %d sprites\n", n);
+        freeTextureLib(&lib);
+        return;
+    }
+
+    // Fondo estirado a toda la pantalla + sprites de 16x16 repartidos
+    TextureRegion bg = getTextureRegion(&lib, maze >= 0 ? maze : 0);
+    sprites[0] = Sprite_CreateFromRegion(bg, 0.0f, 0.0f);
+    sprites[0].dst.w = (float)config.WIN_W;
+    sprites[0].dst.h = (float)config.WIN_H;
+    scatterSprites(&sprites[1], BENCH_STATIC, &lib, false);
+
+    printf("\n=== Dirty rects (%d sprites quietos + fondo, %d frames por caso) ===\n", BENCH_STATIC, BENCH_FRAMES);
+    printf("%8s  %-12s  %10s  %12s\n", "moviles", "modo", "ms/frame", "redibujado %");
+
+    for (int c = 0; c < (int)ARRAY_L(movingCounts); c++)
+    {
+        double redrawn;
+        double ms = runDirtyFrames(sprites, n, movingCounts[c], false, &redrawn);
+        printf("%8d  %-12s  %10.3f  %12.1f\n", movingCounts[c], "completo", ms, redrawn);
+        ms = runDirtyFrames(sprites, n, movingCounts[c], true, &redrawn);
+        printf("%8d  %-12s  %10.3f  %12.1f\n", movingCounts[c], "dirty rects", ms, redrawn);
+    }
+
+    free(sprites);
+    freeTextureLib(&lib);
+}
+
+// Mezcla 'voices' copias del chunk durante 1 s de audio y devuelve los ms que costo.
+static double runMixFrames(Mix_Chunk *chunk, int voices, Sint16 *buffer)
+{
+    for (int v = 0; v < voices; v++)
+        Mixer_Play(chunk, 1.0f / (float)voices, (float)(v % 3 - 1) * 0.5f);
+    Mixer_Render(buffer, 0); // Aplicar los play fuera de la medicion
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int done = 0; done < BENCH_MIX_RATE; done += BENCH_MIX_BUFFER)
+    {
+        memset(buffer, 0, BENCH_MIX_BUFFER * 2 * sizeof(Sint16));
+        Mixer_Render(buffer, SDL_min(BENCH_MIX_BUFFER, BENCH_MIX_RATE - done));
+    }
+    return elapsedMs(start);
+}
+
+// Costo del mezclador por software segun voces y kernel (sin dispositivo de audio).
+void Bench_Mixer(void)
+{
+    static const int voiceCounts[] = {16, 64, 256, 1024};
+
+    // Chunk sintetico: 2 s de un seno estereo S16, mas largo que lo que se mezcla
+    Uint32 frames = BENCH_MIX_RATE * 2;
+    Sint16 *samples = malloc((size_t)frames * 2 * sizeof(Sint16));
+    Sint16 *buffer = malloc(BENCH_MIX_BUFFER * 2 * sizeof(Sint16));
+    if (!samples || !buffer)
+    {
+        printDebug(LOG_ERROR, "Bench mixer: sin memoria para el chunk\n");
+        free(samples);
+        free(buffer);
+        return;
+    }
+    for (Uint32 i = 0; i < frames; i++)
+    {
+        Sint16 v = (Sint16)(sinf((float)i * 2.0f * (float)M_PI * 440.0f / BENCH_MIX_RATE) * 16000.0f);
+        samples[2 * i] = samples[2 * i + 1] = v;
+    }
+    Mix_Chunk chunk = {0, (Uint8 *)samples, frames * 2 * sizeof(Sint16), MIX_MAX_VOLUME};
+
+    printf("\n=== Mezclador (1 s de audio a %d Hz en buffers de %d frames) ===\n", BENCH_MIX_RATE, BENCH_MIX_BUFFER);
+    printf("%8s  %-8s  %10s  %14s  %10s\n", "voces", "kernel", "ms/s audio", "ns/voz/ms", "% nucleo");
+
+    for (int c = 0; c < (int)ARRAY_L(voiceCounts); c++)
+    {
+        for (int k = 0; k < MIXER_KERNEL_COUNT; k++)
+        {
+            if (!Mixer_Init(voiceCounts[c]) || !Mixer_SetKernel((MixerKernel)k))
+                continue;
+            double ms = runMixFrames(&chunk, voiceCounts[c], buffer);
+            printf("%8d  %-8s  %10.3f  %14.2f  %10.2f\n", voiceCounts[c], Mixer_KernelName((MixerKernel)k), ms,
+                   ms * 1e6 / voiceCounts[c] / 1000.0, ms / 10.0);
+        }
+    }
+
+    // Dejar el mezclador como lo configura initAudio
+    Mixer_Quit();
+    if (config.mixer_voices > 0 && Mixer_Init(config.mixer_voices) && !Mixer_Attach())
+        Mixer_Quit();
+
+    free(samples);
+    free(buffer);
+}
+
+// ============================================================
+// Main de benchmarks
+// ============================================================
+
+#ifdef BENCH_MAIN
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} BenchScene;
+
+static const BenchScene scenes[] = {
+    {"sprites", Bench_SpriteBatch},
+    {"jobs",    Bench_Jobs},
+    {"text",    Bench_Text},
+    {"ecs",     Bench_Ecs},
+    {"queue",   Bench_Queue},
+    {"tilemap", Bench_Tilemap},
+    {"camera",  Bench_Camera},
+    {"dirty",   Bench_Dirty},
+    {"mixer",   Bench_Mixer},
+};
+
+int main(int argc, char **argv)
+{
+    bool selected = false;
+
+    // Sin vsync: se mide el costo real de cada frame
+    SDL_SetHint(SDL_HINT_RENDER_VSYNC, "0");
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--software"))
+            SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+        else
+            selected = true;
+    }
+
+    if (!Game_Init())
+    {
+        Game_Destroy();
+        return EXIT_FAILURE;
+    }
+
+    for (int s = 0; s < (int)ARRAY_L(scenes); s++)
+    {
+        bool run = !selected;
+        for (int i = 1; i < argc && !run; i++)
+            run = !strcmp(argv[i], scenes[s].name);
+        if (run)
+            scenes[s].run();
+    }
+
+    Game_Destroy();
+    return 0;
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * @file camera.c
+ * @brief Implementacion de la camara 2D y del recorte de sprites.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "camera.h"
+#include "config.h"
+#include <math.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+static Camera active = {0.0f, 0.0f, 1.0f};
+
+// ============================================================
+// API
+// ============================================================
+
+Camera Camera_Create(void)
+{
+    return (Camera){0.0f, 0.0f, 1.0f};
+}
+
+void Camera_CenterOn(Camera *cam, float worldX, float worldY)
+{
+    float zoom = cam->zoom > 0.0f ? cam->zoom : 1.0f;
+    cam->x = worldX - (float)config.WIN_W * 0.5f / zoom;
+    cam->y = worldY - (float)config.WIN_H * 0.5f / zoom;
+}
+
+SDL_FRect Camera_View(const Camera *cam)
+{
+    if (!cam)
+        cam = &active;
+    float zoom = cam->zoom > 0.0f ? cam->zoom : 1.0f;
+    return (SDL_FRect){cam->x, cam->y, (float)config.WIN_W / zoom, (float)config.WIN_H / zoom};
+}
+
+SDL_FPoint Camera_ScreenToWorld(const Camera *cam, float screenX, float screenY)
+{
+    if (!cam)
+        cam = &active;
+    float zoom = cam->zoom > 0.0f ? cam->zoom : 1.0f;
+    return (SDL_FPoint){cam->x + screenX / zoom, cam->y + screenY / zoom};
+}
+
+void Camera_SetActive(const Camera *cam)
+{
+    active = cam ? *cam : Camera_Create();
+    if (active.zoom <= 0.0f)
+        active.zoom = 1.0f;
+}
+
+const Camera *Camera_GetActive(void)
+{
+    return &active;
+}
+
+// Recorte AABB contra la pantalla logica; con rotacion se agranda la caja
+// hasta el circulo envolvente (centrado en el centro del sprite).
+bool Camera_Project(const Sprite *in, Sprite *out)
+{
+    SDL_FRect d = {
+        (in->dst.x - active.x) * active.zoom,
+        (in->dst.y - active.y) * active.zoom,
+        in->dst.w * active.zoom,
+        in->dst.h * active.zoom
+    };
+
+    float padX = 0.0f, padY = 0.0f;
+    if (in->angle != 0.0)
+    {
+        float radius = 0.5f * sqrtf(d.w * d.w + d.h * d.h);
+        padX = radius - d.w * 0.5f;
+        padY = radius - d.h * 0.5f;
+    }
+    if (d.x + d.w + padX <= 0.0f || d.y + d.h + padY <= 0.0f ||
+        d.x - padX >= (float)config.WIN_W || d.y - padY >= (float)config.WIN_H)
+        return false;
+
+    if (out != in)
+        *out = *in;
+    out->dst = d;
+    return true;
+}
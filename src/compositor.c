@@ -0,0 +1,203 @@
+/**
+ * @file compositor.c
+ * @brief Implementacion del compositor de capas: un target por capa
+ *        cacheada, redibujo solo de las capas sucias y composicion en orden.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "compositor.h"
+#include "config.h"
+#include "engine.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+typedef struct {
+    SDL_Texture *target; // NULL = capa directa
+    bool dirty;
+    bool visible;
+} Layer;
+
+// Capas que cambian en casi todos los frames: se dibujan directo
+static const bool cachedLayer[COMPOSITOR_LAYER_COUNT] = {
+    [COMPOSITOR_BACKGROUND] = true,
+    [COMPOSITOR_WORLD]      = false,
+    [COMPOSITOR_HUD]        = true,
+    [COMPOSITOR_DEBUG]      = false,
+    [COMPOSITOR_GUI]        = true
+};
+
+static Layer layers[COMPOSITOR_LAYER_COUNT];
+static SDL_BlendMode composeBlend = SDL_BLENDMODE_BLEND;
+static SDL_Texture *frameTarget   = NULL; // Target activo antes de abrir la capa
+static int openLayer              = -1;
+static int lastLayer              = COMPOSITOR_LAYER_COUNT;
+static CompositorStats stats      = {0};
+static CompositorStats pending    = {0};
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Copia la capa sobre el frame (tamano logico, sin importar la escala del render).
+static void compose(const Layer *layer)
+{
+    SDL_Rect dst = {0, 0, config.WIN_W, config.WIN_H};
+    SDL_RenderCopy(render, layer->target, NULL, &dst);
+}
+
+// Las capas se dibujan con blend normal sobre transparente, asi que su
+// color queda premultiplicado por alpha: se componen con ONE, 1 - srcA.
+// Si el renderer no acepta el modo custom se usa BLEND (bordes
+// semitransparentes apenas mas oscuros).
+static void setupBlend(void)
+{
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+    composeBlend = SDL_BLENDMODE_BLEND;
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+    {
+        if (!layers[i].target)
+            continue;
+        if (SDL_SetTextureBlendMode(layers[i].target, premultiplied) == 0)
+        {
+            composeBlend = premultiplied;
+            continue;
+        }
+        SDL_SetTextureBlendMode(layers[i].target, SDL_BLENDMODE_BLEND);
+    }
+}
+
+// ============================================================
+// API
+// ============================================================
+
+bool Compositor_Init(bool enabled)
+{
+    Compositor_Destroy();
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+        layers[i] = (Layer){NULL, true, true};
+
+    if (!enabled)
+        return false;
+    if (!SDL_RenderTargetSupported(render))
+    {
+        printDebug(LOG_WARN, "Capas sin cache: el renderer no soporta texturas de render\n");
+        return false;
+    }
+
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+    {
+        if (!cachedLayer[i])
+            continue;
+        layers[i].target = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                             config.WIN_W, config.WIN_H);
+        if (!layers[i].target)
+        {
+            printDebug(LOG_WARN, "No se pudo crear el target de la capa %d: %s. Capas sin cache\n", i, SDL_GetError());
+            Compositor_Destroy();
+            return false;
+        }
+    }
+    setupBlend();
+    printDebug(LOG_INFO, "Capas cacheadas a %dx%d (%s)\n", config.WIN_W, config.WIN_H,
+               composeBlend == SDL_BLENDMODE_BLEND ? "blend" : "premultiplicado");
+    return true;
+}
+
+void Compositor_Destroy(void)
+{
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+    {
+        if (layers[i].target)
+            SDL_DestroyTexture(layers[i].target);
+        layers[i].target = NULL;
+        layers[i].dirty  = true;
+    }
+    openLayer = -1;
+}
+
+void Compositor_MarkDirty(CompositorLayer layer)
+{
+    layers[layer].dirty = true;
+}
+
+void Compositor_Invalidate(void)
+{
+    for (int i = 0; i < COMPOSITOR_LAYER_COUNT; i++)
+        layers[i].dirty = true;
+}
+
+void Compositor_SetVisible(CompositorLayer layer, bool visible)
+{
+    layers[layer].visible = visible;
+}
+
+bool Compositor_Begin(CompositorLayer layer)
+{
+    // Volver a una capa anterior (o a la misma) abre un frame nuevo
+    if ((int)layer <= lastLayer)
+    {
+        stats   = pending;
+        pending = (CompositorStats){0};
+    }
+    lastLayer = layer;
+
+    Layer *l = &layers[layer];
+    if (!l->visible)
+        return false;
+    if (!l->target)
+    {
+        pending.direct++;
+        return true;
+    }
+    if (!l->dirty)
+    {
+        compose(l);
+        pending.reused++;
+        return false;
+    }
+
+    frameTarget = SDL_GetRenderTarget(render);
+    if (SDL_SetRenderTarget(render, l->target) != 0)
+    {
+        // Sin target no hay cache: esta vez se dibuja directo
+        printDebug(LOG_WARN, "No se pudo activar el target de la capa %d: %s\n", (int)layer, SDL_GetError());
+        SDL_SetRenderTarget(render, frameTarget);
+        pending.direct++;
+        return true;
+    }
+
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(render, &r, &g, &b, &a);
+    SDL_SetRenderDrawColor(render, 0, 0, 0, 0);
+    SDL_RenderClear(render);
+    SDL_SetRenderDrawColor(render, r, g, b, a);
+
+    openLayer = layer;
+    pending.redrawn++;
+    return true;
+}
+
+void Compositor_End(void)
+{
+    if (openLayer < 0)
+        return;
+
+    Layer *l = &layers[openLayer];
+    SDL_SetRenderTarget(render, frameTarget);
+    l->dirty  = false;
+    openLayer = -1;
+    compose(l);
+}
+
+CompositorStats Compositor_GetStats(void)
+{
+    return stats;
+}
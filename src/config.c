@@ -1,7 +1,7 @@
 /**
  * @file config.c
  * @brief Implementacion de la carga e impresion de configuracion del motor.
- *        Lee archivos .ini con secciones [Video], [Audio], [Game] y [Debug],
+ *        Lee archivos .ini con secciones [Video], [Audio], [Game], [GUI] y [Debug],
  *        y almacena los valores en una estructura GameConfig.
  */
 
@@ -67,6 +67,12 @@ bool loadConfig(GameConfig *cfg, char *cfg_name)
                 cfg->vsync = temp;
             sscanf(line, "fps=%d", &cfg->fps);
             sscanf(line, "default_monitor=%d", &cfg->defaultMonitor);
+            if(sscanf(line, "render_target=%d", &temp) == 1)
+                cfg->render_target = temp;
+            if(sscanf(line, "dirty_rects=%d", &temp) == 1)
+                cfg->dirty_rects = temp;
+            if(sscanf(line, "layer_cache=%d", &temp) == 1)
+                cfg->layer_cache = temp;
         }
         else if(!strcmp(title, "Audio"))
         {
@@ -74,16 +80,24 @@ bool loadConfig(GameConfig *cfg, char *cfg_name)
             sscanf(line, "music_volume=%d", &cfg->music_volume);
             sscanf(line, "sfx_volume=%d", &cfg->sfx_volume);
             sscanf(line, "audio_frequency=%d", &cfg->audio_frequency);
+            sscanf(line, "mixer_voices=%d", &cfg->mixer_voices);
         }
         else if(!strcmp(title, "Game"))
         {
             if(sscanf(line, "show_fps=%d", &temp) == 1)
                 cfg->show_fps = temp;
+            sscanf(line, "tick_rate=%d", &cfg->tick_rate);
+            sscanf(line, "max_ticks=%d", &cfg->max_ticks);
+        }
+        else if(!strcmp(title, "GUI"))
+        {
+            sscanf(line, "arena_kb=%d", &cfg->gui_arena_kb);
         }
         else if(!strcmp(title, "Debug"))
         {
             if(sscanf(line, "debug_mode=%d", &temp) == 1)
                 cfg->debug_mode = temp;
+            sscanf(line, "headless_frames=%d", &cfg->headless_frames);
         }
     }
     fclose(cfg_file);
@@ -93,7 +107,7 @@ bool loadConfig(GameConfig *cfg, char *cfg_name)
 
 /**
  * @brief Imprime todos los campos de la configuracion a stdout, agrupados
- *        por seccion ([Video], [Audio], [Game], [Debug]). Si el puntero
+ *        por seccion ([Video], [Audio], [Game], [GUI], [Debug]). Si el puntero
  *        es NULL, muestra un mensaje de error via printDebug.
  */
 void printConfig(GameConfig *cfg)
@@ -110,16 +124,25 @@ void printConfig(GameConfig *cfg)
     printf("fullscreen=%d\n", cfg->fullscreen);
     printf("vsync=%d\n", cfg->vsync);
     printf("fps=%d\n", cfg->fps);
-    printf("default_monitor=%d\n\n", cfg->defaultMonitor);
+    printf("default_monitor=%d\n", cfg->defaultMonitor);
+    printf("render_target=%d\n", cfg->render_target);
+    printf("dirty_rects=%d\n", cfg->dirty_rects);
+    printf("layer_cache=%d\n\n", cfg->layer_cache);
     printf("[Audio]\n");
     printf("master_volume=%d\n", cfg->master_volume);
     printf("music_volume=%d\n", cfg->music_volume);
     printf("sfx_volume=%d\n", cfg->sfx_volume);
-    printf("audio_frequency=%d\n\n", cfg->audio_frequency);
+    printf("audio_frequency=%d\n", cfg->audio_frequency);
+    printf("mixer_voices=%d\n\n", cfg->mixer_voices);
     printf("[Game]\n");
-    printf("show_fps=%d\n\n", cfg->show_fps);
+    printf("show_fps=%d\n", cfg->show_fps);
+    printf("tick_rate=%d\n", cfg->tick_rate);
+    printf("max_ticks=%d\n\n", cfg->max_ticks);
+    printf("[GUI]\n");
+    printf("arena_kb=%d\n\n", cfg->gui_arena_kb);
     printf("[Debug]\n");
     printf("debug_mode=%d\n", cfg->debug_mode);
+    printf("headless_frames=%d\n", cfg->headless_frames);
 }
 
 #ifdef CFG_DEBUG
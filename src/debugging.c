@@ -17,6 +17,9 @@
 #include "engine.h"
 #include "gui.h"
 #include "img.h"
+#include "pacer.h"
+#include "compositor.h"
+#include "renderqueue.h"
 #include "text.h"
 #include "tools.h"
 
@@ -55,8 +58,8 @@ static const char *fontFiles[] = {ARCADE_FONT, LCD_FONT, VT_FONT, JERSEY_FONT};
 
 static int fontIndex           = 0;
 static int fontSize            = 24;
-static TTF_Font *debugFont     = NULL;
-static SDL_Texture *previewTex = NULL;
+static Font *debugFont         = NULL; // Referencia del servicio de fuentes
+static Text preview            = {0};  // Solo se redistribuye si cambia el texto o la fuente
 static char previewText[128]   = "AaBbCc 0123456789 !@#";
 static int previewLen          = 21;
 
@@ -73,43 +76,16 @@ static void exitFontDebug(void);
 // Helpers (privados)
 // ============================================================
 
-/// Renderiza la preview del font debug.
-static void rebuildFontPreview(void)
-{
-    if (previewTex)
-    {
-        SDL_DestroyTexture(previewTex);
-        previewTex = NULL;
-    }
-
-    if (!debugFont || previewText[0] == '\0')
-        return;
-
-    SDL_Color white = {255, 255, 255, 255};
-    SDL_Surface *srf = TTF_RenderUTF8_Blended(debugFont, previewText, white);
-    if (!srf)
-        return;
-
-    previewTex = SDL_CreateTextureFromSurface(render, srf);
-    SDL_FreeSurface(srf);
-}
-
-/// Recarga la fuente con el indice y tamanho actuales.
+/// Recarga la fuente con el indice y tamanho actuales. Si otro modulo ya
+/// la tiene cargada (ej: el texto del HUD) se reusa su atlas.
 static void reloadDebugFont(void)
 {
-    if (debugFont)
-    {
-        TTF_CloseFont(debugFont);
-        debugFont = NULL;
-    }
-
     char path[256];
     snprintf(path, sizeof(path), "%s%s", FONTS_DIR, fontFiles[fontIndex]);
-    debugFont = TTF_OpenFont(path, fontSize);
-    if (!debugFont)
-        printDebug(LOG_WARN, "No se pudo cargar fuente '%s': %s\n", path, TTF_GetError());
-
-    rebuildFontPreview();
+    Font *next = Font_Acquire(path, fontSize);
+    Font_Release(debugFont);
+    debugFont = next;
+    Text_SetFont(&preview, debugFont);
 }
 
 // ============================================================
@@ -318,7 +294,7 @@ static void renderPerfMetrics(void)
         return;
 
     int winW = 350;
-    int winH = 140;
+    int winH = 345;
     if (winW > config.WIN_W - 20) winW = config.WIN_W - 20;
     if (winH > config.WIN_H - 20) winH = config.WIN_H - 20;
 
@@ -327,7 +303,7 @@ static void renderPerfMetrics(void)
                  nk_rect(config.WIN_W - winW, 0, winW, winH),
                  NK_WINDOW_BORDER | NK_WINDOW_TITLE))
     {
-        char buffer[32];
+        char buffer[64];
 
         snprintf(buffer, sizeof(buffer), "FPS: %d", (int)(1.0f / deltatime));
         nk_layout_row_dynamic(ctx, 20, 1);
@@ -340,6 +316,43 @@ static void renderPerfMetrics(void)
         snprintf(buffer, sizeof(buffer), "CPU: %.1f%%", getCpuUsage());
         nk_layout_row_dynamic(ctx, 20, 1);
         nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        PacerStats pacing = Pacer_GetStats();
+        snprintf(buffer, sizeof(buffer), "Pacing: %.0f us (avg %.0f)", pacing.last_error_us, pacing.mean_abs_error_us);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        snprintf(buffer, sizeof(buffer), "Max: %.0f us  Resync: %lu", pacing.max_error_us, (unsigned long)pacing.resyncs);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        snprintf(buffer, sizeof(buffer), "Ticks descartados: %d", dropped_ticks);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        RenderQueueStats queue = RenderQueue_GetStats();
+        snprintf(buffer, sizeof(buffer), "Draws: %d  Cmds: %d  Sort: %.3f ms", queue.draw_calls, queue.commands, queue.sort_ms);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        snprintf(buffer, sizeof(buffer), "Tex switches: %d (sin ordenar %d)", queue.texture_switches, queue.unsorted_texture_switches);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        snprintf(buffer, sizeof(buffer), "Redibujado: %.1f%% (%d rects)", queue.redrawn_pct, queue.dirty_rects);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        CompositorStats layers = Compositor_GetStats();
+        snprintf(buffer, sizeof(buffer), "Capas: %d redibujadas, %d en cache", layers.redrawn, layers.reused);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
+
+        GuiArenaStats arena = GUI_GetArenaStats();
+        snprintf(buffer, sizeof(buffer), "GUI arena: %zu/%zu KB (pico %zu, malloc %d)",
+                 arena.used / 1024, arena.size / 1024, arena.peak / 1024, arena.overflow_allocs);
+        nk_layout_row_dynamic(ctx, 20, 1);
+        nk_label(ctx, buffer, NK_TEXT_LEFT);
     }
     else
     {
@@ -364,22 +377,18 @@ static void toggleFontDebug(void)
 
     fontIndex = 0;
     fontSize  = 24;
+    Text_Free(&preview);
+    preview = Text_Create(NULL, 0, 0);
     reloadDebugFont();
     fontDebugActive = true;
 }
 
 static void exitFontDebug(void)
 {
-    if (debugFont)
-    {
-        TTF_CloseFont(debugFont);
-        debugFont = NULL;
-    }
-    if (previewTex)
-    {
-        SDL_DestroyTexture(previewTex);
-        previewTex = NULL;
-    }
+    Text_Free(&preview);
+    preview = (Text){0};
+    Font_Release(debugFont);
+    debugFont = NULL;
     fontDebugActive = false;
 }
 
@@ -427,7 +436,7 @@ static void renderFontDebug(void)
         if (debugFont)
         {
             char info[64];
-            snprintf(info, sizeof(info), "%s  %dpx", fontNames[fontIndex], fontSize);
+            snprintf(info, sizeof(info), "%s  %dpx  (%d fuentes cargadas)", fontNames[fontIndex], fontSize, Font_Count());
             nk_layout_row_dynamic(ctx, 20, 1);
             nk_label(ctx, info, NK_TEXT_CENTERED);
         }
@@ -440,22 +449,14 @@ static void renderFontDebug(void)
     }
     nk_end(ctx);
 
-    // --- Preview renderizada con SDL ---
+    // --- Preview con el atlas de la fuente ---
     previewText[previewLen] = '\0';
-    rebuildFontPreview();
-
-    if (previewTex)
-    {
-        int texW, texH;
-        SDL_QueryTexture(previewTex, NULL, NULL, &texW, &texH);
-
-        SDL_Rect dst = {
-            centerI(config.WIN_W, texW),
-            config.WIN_H / 2 + winH / 2 + 20,
-            texW, texH
-        };
-        SDL_RenderCopy(render, previewTex, NULL, &dst);
-    }
+    if (!debugFont)
+        return;
+    Text_Set(&preview, previewText);
+    preview.rect.x = centerI(config.WIN_W, preview.rect.w);
+    preview.rect.y = config.WIN_H / 2 + winH / 2 + 20;
+    Text_Draw(&preview);
 }
 
 // ============================================================
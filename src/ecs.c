@@ -0,0 +1,378 @@
+/**
+ * @file ecs.c
+ * @brief Implementacion del almacen de entidades SoA: alta/baja con ids
+ *        generacionales, componentes y sistemas en paralelo.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "ecs.h"
+#include "jobs.h"
+#include "renderqueue.h"
+#include "sprites.h"
+#include "tools.h"
+#include <stdlib.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define ECS_INDEX_MASK ((Uint32)ECS_MAX_ENTITIES - 1)
+#define ECS_MOVE_BATCH 1024 // Slots minimos por rango en los sistemas internos
+
+// Argumentos compartidos por los rangos de Ecs_Run.
+typedef struct {
+    EcsWorld   *world;
+    EcsSystemFn fn;
+    void       *data;
+} EcsRunArgs;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+static Uint32 entityIndex(Entity e)
+{
+    return e & ECS_INDEX_MASK;
+}
+
+static Entity makeEntity(Uint32 index, Uint16 generation)
+{
+    return ((Entity)generation << ECS_INDEX_BITS) | index;
+}
+
+// Anota que el contenido de una capa cambio (ver Ecs_LayersChanged).
+static void markLayer(EcsWorld *w, Uint8 layer)
+{
+    w->dirty_layers[layer / 32] |= 1u << (layer % 32);
+}
+
+static bool layerMarked(const EcsWorld *w, Uint8 layer)
+{
+    return w->dirty_layers[layer / 32] & (1u << (layer % 32));
+}
+
+static void runRange(int start, int end, void *data)
+{
+    EcsRunArgs *args = data;
+    args->fn(args->world, start, end, args->data);
+}
+
+// prev = pos; pos += v * dt.
+static void moveRange(EcsWorld *w, int start, int end, void *data)
+{
+    float dt = *(const float *)data;
+    for (int i = start; i < end; i++)
+    {
+        w->prev_x[i] = w->x[i];
+        w->prev_y[i] = w->y[i];
+        if (w->mask[i] & ECS_VELOCITY)
+        {
+            w->x[i] += w->vx[i] * dt;
+            w->y[i] += w->vy[i] * dt;
+        }
+    }
+}
+
+// ============================================================
+// Mundo
+// ============================================================
+
+// Reserva cada columna con su capacidad final: los sistemas nunca ven un realloc.
+bool Ecs_Init(EcsWorld *w, int capacity)
+{
+    *w = (EcsWorld){0};
+    if (capacity <= 0 || capacity > ECS_MAX_ENTITIES)
+    {
+        printDebug(LOG_ERROR, "Capacidad de entidades invalida: %d\n", capacity);
+        return false;
+    }
+
+    size_t n = (size_t)capacity;
+    w->capacity   = capacity;
+    w->entity     = malloc(n * sizeof(Entity));
+    w->mask       = calloc(n, sizeof(Uint8));
+    w->x          = malloc(n * sizeof(float));
+    w->y          = malloc(n * sizeof(float));
+    w->prev_x     = malloc(n * sizeof(float));
+    w->prev_y     = malloc(n * sizeof(float));
+    w->vx         = malloc(n * sizeof(float));
+    w->vy         = malloc(n * sizeof(float));
+    w->texture    = malloc(n * sizeof(SDL_Texture *));
+    w->src        = malloc(n * sizeof(SDL_Rect));
+    w->w          = malloc(n * sizeof(float));
+    w->h          = malloc(n * sizeof(float));
+    w->clip       = malloc(n * sizeof(int));
+    w->anim_start = malloc(n * sizeof(double));
+    w->layer      = calloc(n, sizeof(Uint8));
+    w->sparse     = malloc(n * sizeof(int));
+    w->generation = malloc(n * sizeof(Uint16));
+    w->free_list  = malloc(n * sizeof(int));
+    if (!w->entity || !w->mask || !w->x || !w->y || !w->prev_x || !w->prev_y || !w->vx || !w->vy ||
+        !w->texture || !w->src || !w->w || !w->h || !w->clip || !w->anim_start || !w->layer ||
+        !w->sparse || !w->generation || !w->free_list)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para %d entidades\n", capacity);
+        Ecs_Free(w);
+        return false;
+    }
+
+    // Los indices bajos salen primero de la pila
+    for (int i = 0; i < capacity; i++)
+    {
+        w->sparse[i] = -1;
+        w->generation[i] = 1;
+        w->free_list[i] = capacity - 1 - i;
+    }
+    w->free_count = capacity;
+    return true;
+}
+
+void Ecs_Free(EcsWorld *w)
+{
+    free(w->entity);
+    free(w->mask);
+    free(w->x);
+    free(w->y);
+    free(w->prev_x);
+    free(w->prev_y);
+    free(w->vx);
+    free(w->vy);
+    free(w->texture);
+    free(w->src);
+    free(w->w);
+    free(w->h);
+    free(w->clip);
+    free(w->anim_start);
+    free(w->layer);
+    free(w->sparse);
+    free(w->generation);
+    free(w->free_list);
+    *w = (EcsWorld){0};
+}
+
+// ============================================================
+// Entidades y componentes
+// ============================================================
+
+Entity Ecs_Create(EcsWorld *w, float x, float y)
+{
+    if (w->free_count <= 0)
+    {
+        printDebug(LOG_WARN, "Mundo lleno (%d entidades)\n", w->capacity);
+        return ECS_NULL;
+    }
+
+    Uint32 index = (Uint32)w->free_list[--w->free_count];
+    int slot = w->count++;
+    Entity e = makeEntity(index, w->generation[index]);
+
+    w->sparse[index] = slot;
+    w->entity[slot]  = e;
+    w->mask[slot]    = 0;
+    w->layer[slot]   = 0;
+    w->x[slot] = w->prev_x[slot] = x;
+    w->y[slot] = w->prev_y[slot] = y;
+    return e;
+}
+
+// Borrado por swap con el ultimo slot; la generacion del indice avanza
+// (saltando 0 para que ningun id valido sea ECS_NULL).
+void Ecs_Destroy(EcsWorld *w, Entity e)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+
+    if (w->mask[slot] & ECS_SPRITE)
+        markLayer(w, w->layer[slot]);
+
+    int last = --w->count;
+    if (slot != last)
+    {
+        w->entity[slot]     = w->entity[last];
+        w->mask[slot]       = w->mask[last];
+        w->x[slot]          = w->x[last];
+        w->y[slot]          = w->y[last];
+        w->prev_x[slot]     = w->prev_x[last];
+        w->prev_y[slot]     = w->prev_y[last];
+        w->vx[slot]         = w->vx[last];
+        w->vy[slot]         = w->vy[last];
+        w->texture[slot]    = w->texture[last];
+        w->src[slot]        = w->src[last];
+        w->w[slot]          = w->w[last];
+        w->h[slot]          = w->h[last];
+        w->clip[slot]       = w->clip[last];
+        w->anim_start[slot] = w->anim_start[last];
+        w->layer[slot]      = w->layer[last];
+        w->sparse[entityIndex(w->entity[slot])] = slot;
+    }
+
+    Uint32 index = entityIndex(e);
+    w->sparse[index] = -1;
+    if (++w->generation[index] >= (1u << (32 - ECS_INDEX_BITS)))
+        w->generation[index] = 1;
+    w->free_list[w->free_count++] = (int)index;
+}
+
+bool Ecs_Alive(const EcsWorld *w, Entity e)
+{
+    return Ecs_Slot(w, e) >= 0;
+}
+
+int Ecs_Slot(const EcsWorld *w, Entity e)
+{
+    Uint32 index = entityIndex(e);
+    if (e == ECS_NULL || index >= (Uint32)w->capacity || w->sparse[index] < 0)
+        return -1;
+    int slot = w->sparse[index];
+    return w->entity[slot] == e ? slot : -1;
+}
+
+void Ecs_SetPosition(EcsWorld *w, Entity e, float x, float y)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+    w->x[slot] = w->prev_x[slot] = x;
+    w->y[slot] = w->prev_y[slot] = y;
+    markLayer(w, w->layer[slot]);
+}
+
+void Ecs_SetVelocity(EcsWorld *w, Entity e, float vx, float vy)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+    w->vx[slot] = vx;
+    w->vy[slot] = vy;
+    w->mask[slot] |= ECS_VELOCITY;
+    markLayer(w, w->layer[slot]);
+}
+
+// Con ECS_ANIM el clip manda en src y tamanho: solo cambia la pagina,
+// asi el resultado no depende del orden de SetSprite y SetAnim.
+void Ecs_SetSprite(EcsWorld *w, Entity e, TextureRegion region)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+    w->texture[slot] = region.texture;
+    if (!(w->mask[slot] & ECS_ANIM))
+    {
+        w->src[slot] = region.src;
+        w->w[slot]   = (float)region.src.w;
+        w->h[slot]   = (float)region.src.h;
+    }
+    w->mask[slot] |= ECS_SPRITE;
+    markLayer(w, w->layer[slot]);
+}
+
+void Ecs_SetAnim(EcsWorld *w, Entity e, int clip, double start)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0 || !Clip_Get(clip))
+        return;
+    SDL_Rect first = Clip_Frame(clip, 0);
+    w->clip[slot]       = clip;
+    w->anim_start[slot] = start;
+    w->src[slot]        = first;
+    w->w[slot]          = (float)first.w;
+    w->h[slot]          = (float)first.h;
+    w->mask[slot] |= ECS_ANIM;
+    markLayer(w, w->layer[slot]);
+}
+
+void Ecs_SetLayer(EcsWorld *w, Entity e, Uint8 layer)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+    markLayer(w, w->layer[slot]);
+    markLayer(w, layer);
+    w->layer[slot] = layer;
+}
+
+void Ecs_Remove(EcsWorld *w, Entity e, Uint8 components)
+{
+    int slot = Ecs_Slot(w, e);
+    if (slot < 0)
+        return;
+    w->mask[slot] &= (Uint8)~components;
+    markLayer(w, w->layer[slot]);
+}
+
+// Una entidad que se movio en el ultimo tick (o que anima) cambia en
+// todos los frames: su capa queda marcada para la llamada siguiente, asi
+// tambien se redibuja el frame en que se detiene (la interpolacion la
+// habia dejado a mitad de camino).
+bool Ecs_LayersChanged(EcsWorld *w, Uint8 first, Uint8 last)
+{
+    bool changed = false;
+    for (int layer = first; layer <= last; layer++)
+    {
+        changed |= layerMarked(w, (Uint8)layer);
+        w->dirty_layers[layer / 32] &= ~(1u << (layer % 32));
+    }
+
+    for (int i = 0; i < w->count; i++)
+    {
+        if (!(w->mask[i] & ECS_SPRITE) || w->layer[i] < first || w->layer[i] > last)
+            continue;
+        if ((w->mask[i] & ECS_ANIM) || w->x[i] != w->prev_x[i] || w->y[i] != w->prev_y[i])
+        {
+            markLayer(w, w->layer[i]);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+// ============================================================
+// Sistemas
+// ============================================================
+
+// Reparte [0, count) entre los workers; cada rango es independiente.
+void Ecs_Run(EcsWorld *w, EcsSystemFn fn, void *data, int minBatch)
+{
+    if (!w || !fn || w->count <= 0)
+        return;
+    EcsRunArgs args = {w, fn, data};
+    Jobs_ParallelFor(w->count, minBatch, runRange, &args);
+}
+
+void Ecs_Move(EcsWorld *w, float dt)
+{
+    Ecs_Run(w, moveRange, &dt, ECS_MOVE_BATCH);
+}
+
+// La cola y el batch no son thread-safe: se arma el Sprite de cada entidad en el hilo principal.
+void Ecs_Draw(const EcsWorld *w, float alpha, double now)
+{
+    Ecs_DrawLayers(w, alpha, now, 0, 255);
+}
+
+void Ecs_DrawLayers(const EcsWorld *w, float alpha, double now, Uint8 first, Uint8 last)
+{
+    for (int i = 0; i < w->count; i++)
+    {
+        Uint8 mask = w->mask[i];
+        if (!(mask & ECS_SPRITE) || w->layer[i] < first || w->layer[i] > last)
+            continue;
+
+        SDL_Rect src = w->src[i];
+        if (mask & ECS_ANIM)
+            src = Clip_Frame(w->clip[i], Clip_FrameIndexAt(w->clip[i], now - w->anim_start[i], NULL));
+
+        Sprite s = {
+            .texture = w->texture[i],
+            .src     = src,
+            .dst     = {w->prev_x[i] + (w->x[i] - w->prev_x[i]) * alpha,
+                        w->prev_y[i] + (w->y[i] - w->prev_y[i]) * alpha,
+                        w->w[i], w->h[i]},
+            .flip    = SDL_FLIP_NONE
+        };
+        RenderQueue_Sprite(&s, w->layer[i], 0);
+    }
+}
@@ -9,6 +9,7 @@
 #include "SDL_video.h"
 #include <SDL_mixer.h>
 #include <SDL_image.h>
+#include <math.h>
 
 //#define ARDUINO_ON
 
@@ -16,6 +17,15 @@
 #include "arduino.h"
 #endif
 #include "sprites.h"
+#include "batch.h"
+#include "camera.h"
+#include "compositor.h"
+#include "renderqueue.h"
+#include "screen.h"
+#include "ecs.h"
+#include "pacer.h"
+#include "jobs.h"
+#include "pack.h"
 #include "gui.h"
 #include "engine.h"
 #include "config.h"
@@ -23,6 +33,7 @@
 #include "sound.h"
 #include "tools.h"
 #include "debugging.h"
+#include "font.h"
 #include "text.h"
 
 // ============================================================
@@ -33,6 +44,10 @@
 bool INSTANCE = true;
 int last_frame = 0;
 float deltatime = 0.0f;
+float fixed_deltatime = 0.0f;
+float render_alpha = 0.0f;
+double sim_time = 0.0;
+int dropped_ticks = 0;
 SDL_Renderer *render = NULL;
 SDL_Window *window = NULL;
 SDL_Color renderColor = {
@@ -47,16 +62,83 @@ int MouseY = 0;
 
 TTF_Font *font = NULL;
 texture generalTexLib;
-SDL_Texture *pacSheet;
-AnimatedSprite pacman;
-Sprite laberinto;
+EcsWorld world;   // Objetos del juego (posicion, sprite, animacion)
+Entity pacman;
+Entity laberinto;
+Camera camera = {0.0f, 0.0f, 1.0f};
+
+// -- Privadas (paso fijo) --
+static Uint64 lastCounter = 0;    // Contador de alto rendimiento del frame anterior
+static double accumulator = 0.0;  // Tiempo real pendiente de simular (segundos)
+static int behindTicks = 0;       // Ticks descartados en el atraso actual (0 = al dia)
+
+// -- Privadas (capas) --
+static Camera backgroundCamera = {0.0f, 0.0f, 0.0f}; // Camara con la que se horneo el fondo
+
+// -- Privadas (HUD) --
+#define FPS_SAMPLE 0.5              // Segundos promediados por lectura del contador de FPS
+static Text fpsLabel;               // "FPS" (no cambia)
+static NumberText fpsNumber;        // Valor: solo cambia de quads, nunca de texto
+static double fpsElapsed = 0.0;
+static int fpsFrames = 0;
+
+// -- Privadas (modo headless) --
+static int headlessOverride = 0;      // Frames pedidos por CLI (prioridad sobre el .ini)
+static SDL_Texture *offscreen = NULL; // Target de render cuando no hay pantalla
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Un tick de simulacion de duracion fija 'dt'.
+// Ecs_Move guarda la posicion previa de cada entidad antes de moverla para
+// que Game_Render pueda interpolar entre el tick anterior y el actual.
+static void Game_Tick(float dt)
+{
+	// Guarda la posicion previa y aplica velocidades (las animaciones van por tiempo)
+	Ecs_Move(&world, dt);
+}
+
+// Promedia los FPS cada FPS_SAMPLE segundos; la capa del HUD solo se
+// redibuja cuando cambia el numero mostrado.
+static void updateFpsCounter(double frameTime)
+{
+	if (!config.show_fps)
+		return;
+	fpsElapsed += frameTime;
+	fpsFrames++;
+	if (fpsElapsed < FPS_SAMPLE)
+		return;
+	if (NumberText_Set(&fpsNumber, lround(fpsFrames / fpsElapsed)))
+		Compositor_MarkDirty(COMPOSITOR_HUD);
+	fpsElapsed = 0.0;
+	fpsFrames = 0;
+}
+
+// Encola y despacha las entidades de las capas [first, last] de la cola,
+// proyectadas con la camara del juego.
+static void drawEntities(Uint8 first, Uint8 last)
+{
+	Camera_SetActive(&camera);
+	RenderQueue_Begin();
+	Ecs_DrawLayers(&world, render_alpha, sim_time, first, last);
+	RenderQueue_Flush();
+	Camera_SetActive(NULL);
+}
 
 // ============================================================
 // Funciones publicas - Ciclo de vida
 // ============================================================
 
+// Guarda los frames pedidos por linea de comandos para que Game_Init los aplique
+// despues de leer el .ini.
+void Game_SetHeadless(int frames)
+{
+	headlessOverride = frames > 0 ? frames : 0;
+}
+
 // Inicializa SDL, ventana, render, audio, texto y GUI.
-// Orden: config -> SDL -> IMG/Audio -> ventana -> render -> TTF -> Text -> GUI -> Arduino.
+// Orden: config -> Jobs -> SDL -> IMG/Audio -> ventana -> render -> TTF -> Text -> GUI -> Arduino.
 bool Game_Init()
 {
 	initLog();
@@ -65,8 +147,36 @@ bool Game_Init()
 	if(loadConfig(&config, CONFIG_DIR CFG_FILE) != true)
 		return false;
 
+	// Paso fijo: por defecto un tick por frame objetivo y hasta 5 ticks de recuperacion
+	if(config.tick_rate <= 0)
+		config.tick_rate = config.fps > 0 ? config.fps : 60;
+	if(config.max_ticks <= 0)
+		config.max_ticks = 5;
+	fixed_deltatime = 1.0f / config.tick_rate;
+
+	// Iniciar sistema de jobs (un worker por nucleo). Si falla, todo corre en serie
+	if (!Jobs_Init(0))
+		printDebug(LOG_WARN, "Sistema de jobs no disponible (continuando en un solo hilo)\n");
+
+	// Assets pre-decodificados; sin paquete se cargan los archivos sueltos
+	Pack_Open(PACK_FILE);
+
 	Uint32 windowFlags = SDL_WINDOW_RESIZABLE | (config.fullscreen ? SDL_WINDOW_FULLSCREEN : 0);
 
+	// Headless: drivers dummy, ventana oculta, sin vsync ni limite de fps
+	if(headlessOverride > 0)
+		config.headless_frames = headlessOverride;
+	bool headless = config.headless_frames > 0;
+	if(headless)
+	{
+		SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+		SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+		config.fullscreen = false;
+		config.vsync = false;
+		config.fps = 0;
+		windowFlags = SDL_WINDOW_HIDDEN;
+	}
+
 	// Iniciar SDL (video)
 	if (SDL_Init(SDL_INIT_VIDEO) != 0)
 	{
@@ -76,7 +186,8 @@ bool Game_Init()
 
 	// Iniciar subsistemas de textura y audio
 	initTexture();
-	initAudio();
+	if (initAudio())
+		Sound_InitBank(SFX_DIR); // Efectos en memoria: reproducir no toca el disco
 
 	// Validar monitor: si no existe el configurado, usar el default (0)
 	if(SDL_GetNumVideoDisplays() < config.defaultMonitor)
@@ -92,6 +203,8 @@ bool Game_Init()
 
 	// Crear renderer con aceleracion por hardware (y vsync si esta habilitado en config)
 	Uint32 renderFlags = SDL_RENDERER_ACCELERATED | (config.vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+	if(headless)
+		renderFlags = SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE;
 	render = SDL_CreateRenderer(window, -1, renderFlags);
 	if (!render)
 	{
@@ -99,8 +212,27 @@ bool Game_Init()
 		return false;
 	}
 
-	// Escala inicial 1:1 (ventana arranca al tamanho configurado)
+	// Headless: todo se dibuja sobre una textura fuera de pantalla
+	if(headless)
+	{
+		offscreen = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, config.WIN_W, config.WIN_H);
+		if (!offscreen || SDL_SetRenderTarget(render, offscreen) != 0)
+		{
+			printDebug(LOG_ERROR, "No se pudo crear el target offscreen: %s\n", SDL_GetError());
+			return false;
+		}
+		printDebug(LOG_INFO, "Modo headless: %d frames (%dx%d, software)\n", config.headless_frames, config.WIN_W, config.WIN_H);
+	}
+
+	// Escala inicial 1:1 (ventana arranca al tamanho configurado). Con
+	// render_target el frame se dibuja a resolucion logica y se escala una vez
 	SDL_RenderSetScale(render, 1.0f, 1.0f);
+	Screen_Init(config.WIN_W, config.WIN_H, config.render_target && !headless);
+	if (config.dirty_rects)
+		RenderQueue_SetDirtyRects(true);
+	// Con dirty rects la cola ya retiene fondo y mundo en un solo flush
+	Compositor_Init(config.layer_cache);
+	Compositor_SetVisible(COMPOSITOR_BACKGROUND, !RenderQueue_IsRetained());
 
 	// Iniciar SDL_ttf
 	if (TTF_Init() == -1)
@@ -114,7 +246,7 @@ bool Game_Init()
 		return false;
 
 	// Iniciar GUI (Nuklear)
-	if (!GUI_Init(window, render, FONTS_DIR JERSEY_FONT, 30))
+	if (!GUI_Init(window, render, FONTS_DIR JERSEY_FONT, 30, config.gui_arena_kb))
 	{
 		printDebug(LOG_ERROR, "No se pudo iniciar GUI\n");
 		return false;
@@ -131,14 +263,39 @@ bool Game_Init()
 // Crea los textos del HUD (FPS, mouse).
 void Game_Setup()
 {
+	// Todas las imagenes de SPRITES_DIR comparten paginas de atlas
 	generalTexLib = initTextureLib(SPRITES_DIR);
-	laberinto = Sprite_CreateFull(generalTexLib.textures_array[0], 0, 24.0f);
+	TextureRegion maze = getTextureRegion(&generalTexLib, findTexture(&generalTexLib, "Laberinto_224x248.png"));
 
-	// Cargar spritesheet de pacman directamente
-	pacSheet = IMG_LoadTexture(render, SPRITES_DIR "general_sheet(Corrected 16x16px).png");
+	// Objetos del juego como entidades (posicion + sprite + animacion)
+	if (!Ecs_Init(&world, 1024))
+		printDebug(LOG_ERROR, "No se pudo crear el mundo de entidades\n");
+	laberinto = Ecs_Create(&world, 0.0f, 24.0f);
+	Ecs_SetSprite(&world, laberinto, maze);
+	Ecs_SetLayer(&world, laberinto, RENDER_LAYER_BACKGROUND);
+
+	// Spritesheet de pacman: los frames se desplazan al origen de su region
+	TextureRegion pacSheet = getTextureRegion(&generalTexLib, findTexture(&generalTexLib, "general_sheet(Corrected 16x16px).png"));
 	Animation eat = Anim_CreateFromSheet(16, 16, 3, 0, 3, 15.0f, true);
-	Animation anims[] = {eat};
-	pacman = ASprite_Create(pacSheet, anims, 1, 100.0f, 100.0f);
+	Anim_Offset(&eat, pacSheet.src.x, pacSheet.src.y);
+	int eatClip = Clip_FromAnimation(&eat);
+	Anim_Free(&eat);
+	pacman = Ecs_Create(&world, 100.0f, 100.0f);
+	Ecs_SetSprite(&world, pacman, pacSheet);
+	Ecs_SetAnim(&world, pacman, eatClip, sim_time);
+	Ecs_SetLayer(&world, pacman, RENDER_LAYER_WORLD);
+
+	// Contador de FPS: etiqueta fija y numero de 3 cifras alineado a la derecha
+	fpsLabel = Text_Create("FPS", 8, 4);
+	fpsNumber = NumberText_Create(NULL, fpsLabel.rect.x + fpsLabel.rect.w + 6, 4, 3, 0);
+	NumberText_Set(&fpsNumber, 0);
+	Compositor_SetVisible(COMPOSITOR_HUD, config.show_fps);
+
+	// El primer frame no debe simular el tiempo de carga
+	lastCounter = SDL_GetPerformanceCounter();
+	accumulator = 0.0;
+	behindTicks = 0;
+	Pacer_Init(config.fps);
 }
 
 // Procesa eventos SDL: cierre, teclas, mouse.
@@ -182,12 +339,16 @@ void Game_KeyboardInput()
 			}
 			case(SDL_WINDOWEVENT):
 			{
-				if (event.window.event == SDL_WINDOWEVENT_RESIZED)
-				{
-					float sx = (float)event.window.data1 / config.WIN_W; // ej: 1920 / 960 = 2.0 <- Escala horizontal del juego
-					float sy = (float)event.window.data2 / config.WIN_H; // Escala vertical del juego
-					SDL_RenderSetScale(render, sx, sy);
-				}
+				if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+					Screen_Resize(event.window.data1, event.window.data2);
+				break;
+			}
+			case(SDL_RENDER_TARGETS_RESET):
+			case(SDL_RENDER_DEVICE_RESET):
+			{
+				// El contenido de las texturas de render se perdio
+				RenderQueue_Invalidate();
+				Compositor_Invalidate();
 				break;
 			}
 			default:
@@ -197,12 +358,17 @@ void Game_KeyboardInput()
 	GUI_InputEnd();
 }
 
-// Calcula deltatime y espera el tiempo restante para cumplir el framerate objetivo.
+// Calcula deltatime, ejecuta los ticks de simulacion pendientes y
+// espera el tiempo restante para cumplir el framerate objetivo.
 void Game_UpdateFrame()
 {
-	Uint32 actualTime = SDL_GetTicks();
-	deltatime = (actualTime - last_frame) / 1000.0f;
-	last_frame = actualTime;
+	last_frame = SDL_GetTicks();
+
+	Uint64 now = SDL_GetPerformanceCounter();
+	double frameTime = (double)(now - lastCounter) / (double)SDL_GetPerformanceFrequency();
+	lastCounter = now;
+	deltatime = (float)frameTime;
+	updateFpsCounter(frameTime);
 
 	SDL_GetMouseState(&MouseX, &MouseY);
 
@@ -219,52 +385,148 @@ void Game_UpdateFrame()
 	}
 
 	*/
-	ASprite_Update(&pacman, deltatime);
 
-	float sx, sy;
-	SDL_RenderGetScale(render, &sx, &sy);
-	MouseX = (int)(MouseX / sx);
-	MouseY = (int)(MouseY / sy);
+	// Simulacion de paso fijo: 0..max_ticks ticks por frame
+	double tick = 1.0 / config.tick_rate;
+	int ticks = 0;
+	accumulator += frameTime;
+	while (accumulator >= tick && ticks < config.max_ticks)
+	{
+		Game_Tick(fixed_deltatime);
+		accumulator -= tick;
+		sim_time += tick;
+		ticks++;
+	}
+
+	// Spiral of death: el atraso que no cupo en max_ticks se descarta
+	// (conservando la fase dentro del tick para no romper la interpolacion)
+	// Se avisa una vez al entrar en atraso y otra al salir, con el total
+	if (accumulator >= tick)
+	{
+		int dropped = (int)(accumulator / tick);
+		if (behindTicks == 0)
+			printDebug(LOG_WARN, "Simulacion atrasada, se descartan %d ticks\n", dropped);
+		behindTicks += dropped;
+		dropped_ticks += dropped;
+		accumulator = fmod(accumulator, tick);
+	}
+	else if (behindTicks > 0)
+	{
+		printDebug(LOG_WARN, "Simulacion al dia: se descartaron %d ticks en total\n", behindTicks);
+		behindTicks = 0;
+	}
+	render_alpha = (float)(accumulator / tick);
+
+	Screen_WindowToLogical(&MouseX, &MouseY);
 
-	int WaitTime = FRAME_TIME_MS(config.fps) - (SDL_GetTicks() - actualTime);
-	if (WaitTime > 0 && WaitTime <= FRAME_TIME_MS(config.fps))
-		SDL_Delay(WaitTime);
+	Pacer_Wait();
 }
 
 // Limpia pantalla, dibuja debug/HUD/GUI y presenta el frame.
 void Game_Render()
 {
-	SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
-	SDL_RenderClear(render);
+	Screen_BeginFrame();
+	// Con dirty rects la cola cubre toda la pantalla con el frame retenido
+	if (!RenderQueue_IsRetained())
+	{
+		SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+		SDL_RenderClear(render);
+	}
 
-	Sprite_Draw(&laberinto);
-	ASprite_Draw(&pacman);
+	// El frame se compone por capas (ver compositor.h): las cacheadas solo
+	// se redibujan cuando se marcan sucias, si no se copia su textura.
+	// Los sprites se encolan por capa y se despachan ordenados (una llamada
+	// por tramo de textura), con posiciones interpoladas entre el tick
+	// anterior y el actual. El mundo se proyecta con la camara (lo que queda
+	// fuera no se envia); debug y GUI van en coordenadas de pantalla
+
+	// Fondo: cacheado mientras no se mueva la camara ni cambien sus entidades
+	// (si alguna se mueve o anima, se redibuja en cada frame)
+	bool backgroundChanged = Ecs_LayersChanged(&world, RENDER_LAYER_BACKGROUND, RENDER_LAYER_WORLD - 1);
+	if (backgroundChanged || camera.x != backgroundCamera.x || camera.y != backgroundCamera.y ||
+		camera.zoom != backgroundCamera.zoom)
+	{
+		Compositor_MarkDirty(COMPOSITOR_BACKGROUND);
+		backgroundCamera = camera;
+	}
+	if (Compositor_Begin(COMPOSITOR_BACKGROUND))
+	{
+		drawEntities(RENDER_LAYER_BACKGROUND, RENDER_LAYER_WORLD - 1);
+		Compositor_End();
+	}
 
-	renderDebug();
-	GUI_Render();
-	SDL_RenderPresent(render);
+	if (Compositor_Begin(COMPOSITOR_WORLD))
+	{
+		drawEntities(RenderQueue_IsRetained() ? RENDER_LAYER_BACKGROUND : RENDER_LAYER_WORLD, 255);
+		Compositor_End();
+	}
+
+	// HUD: se compone desde su cache hasta que cambia algun valor
+	if (Compositor_Begin(COMPOSITOR_HUD))
+	{
+		SpriteBatch_Begin();
+		Text_Draw(&fpsLabel);
+		NumberText_Draw(&fpsNumber);
+		SpriteBatch_Flush();
+		Compositor_End();
+	}
+
+	if (Compositor_Begin(COMPOSITOR_DEBUG))
+	{
+		renderDebug();
+		Compositor_End();
+	}
+
+	// GUI: si Nuklear armo los mismos comandos que el frame anterior se
+	// reusa la capa y se evita nk_convert
+	Compositor_SetVisible(COMPOSITOR_GUI, !GUI_IsEmpty());
+	if (GUI_Changed())
+		Compositor_MarkDirty(COMPOSITOR_GUI);
+	if (Compositor_Begin(COMPOSITOR_GUI))
+	{
+		GUI_Render();
+		Compositor_End();
+	}
+	else
+		GUI_Discard();
+
+	Screen_Present();
 }
 
 // Libera todos los recursos en orden inverso a la inicializacion.
 void Game_Destroy()
 {
-	Text_QuitSystem();
 	exitDebug();
+	Text_Free(&fpsLabel);
+	Text_QuitSystem();
 
 	#ifdef ARDUINO_ON
 	arduinoDisconnect();
 	#endif
 
 	GUI_Destroy();
+	Font_QuitSystem();
+	Compositor_Destroy();
+	RenderQueue_Destroy();
+	SpriteBatch_Destroy();
+
+	// Las texturas se destruyen antes que el renderer que las creo
+	Ecs_Free(&world);
+	Clip_FreeAll();
+	freeTextureLib(&generalTexLib);
+	Screen_Destroy();
+	if (offscreen)
+		SDL_DestroyTexture(offscreen);
+	offscreen = NULL;
 
 	SDL_DestroyRenderer(render);
 	SDL_DestroyWindow(window);
 
-	ASprite_Free(&pacman);
-	SDL_DestroyTexture(pacSheet);
-
 	quitTexture();
+	Sound_QuitBank();
 	quitAudio();
+	Pack_Close(); // Despues de liberar texturas y chunks que apuntan al paquete
+	Jobs_Quit();
 	SDL_Quit();
 	closeLog();
 }
@@ -0,0 +1,382 @@
+/**
+ * @file font.c
+ * @brief Implementacion del servicio de fuentes: cache (ruta, tamanho) ->
+ *        handle con referencias y atlas de glyphs compartido por handle.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#define _POSIX_C_SOURCE 200809L
+#include "font.h"
+#include "atlas.h"
+#include "engine.h"
+#include "fontcache.h"
+#include "tools.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define FONT_PAGE_SIZE 1024
+#define FONT_PADDING   1
+#define FONT_WHITE     4          // Lado del bloque blanco del atlas
+#define FONT_ITEMS     (FONT_GLYPHS + 1) // Glyphs mas el bloque blanco
+
+// Las variantes de 32 bits reemplazan a las de Uint16 desde SDL_ttf 2.0.18
+#if SDL_TTF_COMPILEDVERSION >= SDL_VERSIONNUM(2, 0, 18)
+#define RenderGlyph(f, c, col)             TTF_RenderGlyph32_Blended(f, c, col)
+#define GlyphMetrics(f, c, x0, x1, y0, y1, adv) TTF_GlyphMetrics32(f, c, x0, x1, y0, y1, adv)
+#define GlyphProvided(f, c)                TTF_GlyphIsProvided32(f, c)
+#define GlyphKerning(f, a, b)              TTF_GetFontKerningSizeGlyphs32(f, a, b)
+#else
+#define RenderGlyph(f, c, col)             TTF_RenderGlyph_Blended(f, (Uint16)(c), col)
+#define GlyphMetrics(f, c, x0, x1, y0, y1, adv) TTF_GlyphMetrics(f, (Uint16)(c), x0, x1, y0, y1, adv)
+#define GlyphProvided(f, c)                TTF_GlyphIsProvided(f, (Uint16)(c))
+#define GlyphKerning(f, a, b)              TTF_GetFontKerningSizeGlyphs(f, (Uint16)(a), (Uint16)(b))
+#endif
+
+/** @brief Glyph guardado en la cache: metricas y tamanho de su superficie ARGB8888 (los pixeles van a continuacion). */
+typedef struct {
+    int advance;
+    int offset_x;
+    int w, h;         // 0 = sin superficie (espacio o glyph ausente)
+} CachedGlyph;
+
+/** @brief Header del payload de la cache de glyphs. */
+typedef struct {
+    float bake_ms;    // Lo que costo rasterizar (para informar el ahorro)
+    int count;        // FONT_GLYPHS
+} GlyphCacheHeader;
+
+/** @brief Fuentes cargadas (una por ruta y tamanho). */
+static Font **fonts   = NULL;
+static int fontCount  = 0;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+/** @brief Milisegundos desde 'start' (contador de alto rendimiento). */
+static double msSince(Uint64 start)
+{
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/** @brief Nombre del archivo de cache: nombre de la TTF sin extension y tamanho. */
+static void cacheName(char *out, size_t outSize, const char *path, int size)
+{
+    const char *base = strrchr(path, '/');
+    base = base ? base + 1 : path;
+    const char *dot = strrchr(base, '.');
+    int len = dot ? (int)(dot - base) : (int)strlen(base);
+    snprintf(out, outSize, "font_%.*s_%d", len, base, size);
+}
+
+/** @brief Clave de cache: los glyphs dependen de la TTF, el tamanho, el rango y el estilo. */
+static Uint64 glyphKey(const Font *font)
+{
+    int params[] = {FONT_FIRST_GLYPH, FONT_LAST_GLYPH, SDL_TTF_COMPILEDVERSION,
+                    TTF_GetFontStyle(font->ttf), TTF_GetFontHinting(font->ttf), (int)sizeof(CachedGlyph)};
+    return FontCache_Key(font->path, (float)font->size, params, sizeof(params));
+}
+
+/**
+ * @brief Rasteriza los glyphs Latin-1 en blanco con TTF_RenderGlyph_Blended.
+ *
+ * Completa advance/offset_x de cada glyph y deja su superficie en
+ * 'surfaces' (NULL para los vacios).
+ */
+static void rasterizeGlyphs(Font *font, SDL_Surface **surfaces)
+{
+    const SDL_Color white = {255, 255, 255, 255};
+    for (int i = 0; i < FONT_GLYPHS; i++)
+    {
+        Uint32 ch = (Uint32)(FONT_FIRST_GLYPH + i);
+        FontGlyph *g = &font->glyphs[i];
+
+        int minx = 0, maxx = 0, miny = 0, maxy = 0;
+        if (!GlyphProvided(font->ttf, ch) || GlyphMetrics(font->ttf, ch, &minx, &maxx, &miny, &maxy, &g->advance) != 0)
+            continue;
+        g->offset_x = minx < 0 ? minx : 0;
+
+        // El espacio (y otros glyphs vacios) solo avanzan el cursor
+        if (maxx > minx)
+            surfaces[i] = RenderGlyph(font->ttf, ch, white);
+    }
+}
+
+/**
+ * @brief Recrea las superficies y metricas de los glyphs desde la cache.
+ * @return false si el payload no corresponde (se rasteriza normalmente).
+ */
+static bool loadCachedGlyphs(Font *font, SDL_Surface **surfaces, const Uint8 *data, size_t size)
+{
+    const GlyphCacheHeader *hdr = (const GlyphCacheHeader *)data;
+    if (size < sizeof(*hdr) + FONT_GLYPHS * sizeof(CachedGlyph) || hdr->count != FONT_GLYPHS)
+        return false;
+
+    const Uint8 *end = data + size;
+    const Uint8 *p = data + sizeof(*hdr);
+    for (int i = 0; i < FONT_GLYPHS; i++)
+    {
+        CachedGlyph cg;
+        memcpy(&cg, p, sizeof(cg));
+        p += sizeof(cg);
+
+        FontGlyph *g = &font->glyphs[i];
+        g->advance  = cg.advance;
+        g->offset_x = cg.offset_x;
+        if (cg.w <= 0 || cg.h <= 0)
+            continue;
+
+        size_t row = (size_t)cg.w * 4;
+        if ((size_t)(end - p) < row * (size_t)cg.h)
+            return false;
+        surfaces[i] = SDL_CreateRGBSurfaceWithFormat(0, cg.w, cg.h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!surfaces[i])
+            return false;
+        for (int y = 0; y < cg.h; y++)
+            memcpy((Uint8 *)surfaces[i]->pixels + (size_t)y * (size_t)surfaces[i]->pitch, p + (size_t)y * row, row);
+        p += row * (size_t)cg.h;
+    }
+    return p == end;
+}
+
+/** @brief Guarda metricas y superficies de los glyphs (solo si todas son ARGB8888). */
+static void saveCachedGlyphs(const Font *font, const char *name, Uint64 key, SDL_Surface **surfaces, float bakeMs)
+{
+    size_t size = sizeof(GlyphCacheHeader) + FONT_GLYPHS * sizeof(CachedGlyph);
+    for (int i = 0; i < FONT_GLYPHS; i++)
+    {
+        if (!surfaces[i])
+            continue;
+        if (surfaces[i]->format->format != SDL_PIXELFORMAT_ARGB8888)
+            return;
+        size += (size_t)surfaces[i]->w * (size_t)surfaces[i]->h * 4;
+    }
+
+    Uint8 *blob = malloc(size);
+    if (!blob)
+        return;
+    GlyphCacheHeader hdr = {bakeMs, FONT_GLYPHS};
+    memcpy(blob, &hdr, sizeof(hdr));
+    Uint8 *p = blob + sizeof(hdr);
+    for (int i = 0; i < FONT_GLYPHS; i++)
+    {
+        const FontGlyph *g = &font->glyphs[i];
+        SDL_Surface *surf = surfaces[i];
+        CachedGlyph cg = {g->advance, g->offset_x, surf ? surf->w : 0, surf ? surf->h : 0};
+        memcpy(p, &cg, sizeof(cg));
+        p += sizeof(cg);
+        if (!surf)
+            continue;
+        size_t row = (size_t)surf->w * 4;
+        for (int y = 0; y < surf->h; y++)
+            memcpy(p + (size_t)y * row, (const Uint8 *)surf->pixels + (size_t)y * (size_t)surf->pitch, row);
+        p += row * (size_t)surf->h;
+    }
+    FontCache_Save(name, key, blob, size);
+    free(blob);
+}
+
+/** @brief Region y UVs de una superficie empaquetada. */
+static void placeGlyph(FontGlyph *g, int page, SDL_Rect rect, const float *invW, const float *invH)
+{
+    g->page = page;
+    g->src  = rect;
+    g->u0 = (float)rect.x * invW[page];
+    g->v0 = (float)rect.y * invH[page];
+    g->u1 = (float)(rect.x + rect.w) * invW[page];
+    g->v1 = (float)(rect.y + rect.h) * invH[page];
+}
+
+/**
+ * @brief Rasteriza (o lee de la cache en disco) los glyphs Latin-1 y los
+ *        empaqueta con Atlas_Build junto con un bloque blanco.
+ */
+static bool buildAtlas(Font *font)
+{
+    SDL_Surface *surfaces[FONT_ITEMS] = {0};
+    int pageOf[FONT_ITEMS];
+    SDL_Rect rects[FONT_ITEMS];
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < FONT_GLYPHS; i++)
+        font->glyphs[i].page = -1;
+    font->white.page = -1;
+
+    char name[128];
+    cacheName(name, sizeof(name), font->path, font->size);
+    Uint64 key = glyphKey(font);
+    size_t cachedSize = 0;
+    Uint8 *cached = FontCache_Load(name, key, &cachedSize);
+    bool fromCache = cached && loadCachedGlyphs(font, surfaces, cached, cachedSize);
+    float bakedMs = fromCache ? ((const GlyphCacheHeader *)cached)->bake_ms : 0.0f;
+    free(cached);
+    if (!fromCache)
+    {
+        for (int i = 0; i < FONT_GLYPHS; i++)
+        {
+            SDL_FreeSurface(surfaces[i]);
+            surfaces[i] = NULL;
+            font->glyphs[i] = (FontGlyph){.page = -1};
+        }
+        rasterizeGlyphs(font, surfaces);
+        bakedMs = (float)msSince(start);
+        saveCachedGlyphs(font, name, key, surfaces, bakedMs);
+    }
+
+    // Bloque blanco: la GUI dibuja sus formas con el mismo atlas que el texto
+    surfaces[FONT_GLYPHS] = SDL_CreateRGBSurfaceWithFormat(0, FONT_WHITE, FONT_WHITE, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (surfaces[FONT_GLYPHS])
+        SDL_FillRect(surfaces[FONT_GLYPHS], NULL, 0xFFFFFFFFu);
+
+    font->page_count = Atlas_Build(surfaces, FONT_ITEMS, FONT_PAGE_SIZE, FONT_PADDING, &font->pages, pageOf, rects);
+    if (font->page_count <= 0 || font->page_count > FONT_MAX_PAGES)
+    {
+        printDebug(LOG_ERROR, "No se pudo crear el atlas de %s a %d (%d paginas)\n", font->path, font->size, font->page_count);
+        Atlas_FreePages(font->pages, font->page_count);
+        font->pages = NULL;
+        font->page_count = 0;
+        for (int i = 0; i < FONT_ITEMS; i++)
+            SDL_FreeSurface(surfaces[i]);
+        return false;
+    }
+
+    float invW[FONT_MAX_PAGES], invH[FONT_MAX_PAGES];
+    for (int p = 0; p < font->page_count; p++)
+    {
+        int w = 1, h = 1;
+        GetTextureSize(font->pages[p], &w, &h);
+        invW[p] = 1.0f / (float)w;
+        invH[p] = 1.0f / (float)h;
+        SDL_SetTextureBlendMode(font->pages[p], SDL_BLENDMODE_BLEND);
+    }
+
+    for (int i = 0; i < FONT_ITEMS; i++)
+    {
+        if (!surfaces[i])
+            continue;
+        if (pageOf[i] >= 0)
+            placeGlyph(i < FONT_GLYPHS ? &font->glyphs[i] : &font->white, pageOf[i], rects[i], invW, invH);
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    double ms = msSince(start);
+    if (fromCache)
+        printDebug(LOG_INFO, "Atlas de %s a %d desde cache: %d paginas, %.2f ms (rasterizar costo %.2f ms, ahorro %.2f ms)\n",
+                   font->path, font->size, font->page_count, ms, bakedMs, bakedMs - ms);
+    else
+        printDebug(LOG_INFO, "Atlas de %s a %d: %d glyphs en %d paginas (%.2f ms)\n",
+                   font->path, font->size, FONT_GLYPHS, font->page_count, ms);
+    return true;
+}
+
+static void destroyFont(Font *font)
+{
+    Atlas_FreePages(font->pages, font->page_count);
+    if (font->ttf)
+        TTF_CloseFont(font->ttf);
+    free(font->path);
+    free(font);
+}
+
+// ============================================================
+// API
+// ============================================================
+
+Font *Font_Acquire(const char *path, int size)
+{
+    if (!path)
+        return NULL;
+    for (int i = 0; i < fontCount; i++)
+    {
+        if (fonts[i]->size == size && strcmp(fonts[i]->path, path) == 0)
+        {
+            fonts[i]->refs++;
+            return fonts[i];
+        }
+    }
+
+    Font **grown = realloc(fonts, (size_t)(fontCount + 1) * sizeof(Font *));
+    Font *font = calloc(1, sizeof(Font));
+    if (grown)
+        fonts = grown;
+    if (!grown || !font)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para la fuente %s\n", path);
+        free(font);
+        return NULL;
+    }
+
+    font->path = strdup(path);
+    font->size = size;
+    font->ttf  = font->path ? TTF_OpenFont(path, size) : NULL;
+    if (!font->ttf)
+    {
+        printDebug(LOG_ERROR, "No se pudo cargar fuente '%s': %s\n", path, TTF_GetError());
+        destroyFont(font);
+        return NULL;
+    }
+    font->height    = TTF_FontHeight(font->ttf);
+    font->line_skip = TTF_FontLineSkip(font->ttf);
+    font->kerning   = TTF_GetFontKerning(font->ttf) != 0;
+    if (!buildAtlas(font))
+    {
+        destroyFont(font);
+        return NULL;
+    }
+
+    font->refs = 1;
+    fonts[fontCount++] = font;
+    return font;
+}
+
+void Font_Release(Font *font)
+{
+    if (!font || --font->refs > 0)
+        return;
+
+    for (int i = 0; i < fontCount; i++)
+    {
+        if (fonts[i] == font)
+        {
+            fonts[i] = fonts[--fontCount];
+            break;
+        }
+    }
+    destroyFont(font);
+}
+
+const FontGlyph *Font_Glyph(const Font *font, Uint32 *cp)
+{
+    if (*cp < FONT_FIRST_GLYPH || *cp > FONT_LAST_GLYPH || font->glyphs[*cp - FONT_FIRST_GLYPH].advance == 0)
+        *cp = FONT_FALLBACK;
+    return &font->glyphs[*cp - FONT_FIRST_GLYPH];
+}
+
+int Font_Kerning(const Font *font, Uint32 prev, Uint32 cp)
+{
+    return font->kerning && prev ? GlyphKerning(font->ttf, prev, cp) : 0;
+}
+
+int Font_Count(void)
+{
+    return fontCount;
+}
+
+void Font_QuitSystem(void)
+{
+    for (int i = 0; i < fontCount; i++)
+    {
+        printDebug(LOG_WARN, "Fuente %s a %d sin liberar (%d referencias)\n", fonts[i]->path, fonts[i]->size, fonts[i]->refs);
+        destroyFont(fonts[i]);
+    }
+    free(fonts);
+    fonts = NULL;
+    fontCount = 0;
+    TTF_Quit();
+}
@@ -0,0 +1,125 @@
+/**
+ * @file fontcache.c
+ * @brief Implementacion de la cache en disco de atlas de fuentes: clave
+ *        por contenido de la TTF y archivo con header verificado.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "fontcache.h"
+#include "config.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+/** @brief Cabecera de un archivo de cache (32 bytes). */
+typedef struct {
+    Uint32 magic;    // FONTCACHE_MAGIC
+    Uint32 version;  // FONTCACHE_VERSION
+    Uint64 key;      // FontCache_Key con la que se horneo
+    Uint64 size;     // Bytes del payload
+    Uint64 checksum; // FNV-1a del payload (detecta archivos truncados)
+} FontCacheHeader;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+static void cachePath(char *out, size_t outSize, const char *name)
+{
+    snprintf(out, outSize, "%s%s.bin", CACHE_DIR, name);
+}
+
+// ============================================================
+// API
+// ============================================================
+
+Uint64 FontCache_Key(const char *fontPath, float size, const void *params, size_t paramsSize)
+{
+    FILE *f = fontPath ? fopen(fontPath, "rb") : NULL;
+    if (!f)
+        return 0;
+
+    long length = fileSize(f);
+    Uint8 *bytes = length > 0 ? malloc((size_t)length) : NULL;
+    bool ok = bytes && fread(bytes, 1, (size_t)length, f) == (size_t)length;
+    fclose(f);
+    if (!ok)
+    {
+        free(bytes);
+        return 0;
+    }
+
+    Uint32 version = FONTCACHE_VERSION;
+    Uint64 key = hashBytes(bytes, (size_t)length, HASH_SEED);
+    key = hashBytes(&size, sizeof(size), key);
+    key = hashBytes(&version, sizeof(version), key);
+    if (params)
+        key = hashBytes(params, paramsSize, key);
+    free(bytes);
+    return key ? key : 1;
+}
+
+void *FontCache_Load(const char *name, Uint64 key, size_t *size)
+{
+    if (!key)
+        return NULL;
+
+    char path[256];
+    cachePath(path, sizeof(path), name);
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+
+    FontCacheHeader header;
+    void *data = NULL;
+    if (fread(&header, sizeof(header), 1, f) == 1 && header.magic == FONTCACHE_MAGIC &&
+        header.version == FONTCACHE_VERSION && header.key == key && header.size > 0 &&
+        header.size == (Uint64)(fileSize(f) - (long)sizeof(header)))
+    {
+        fseek(f, (long)sizeof(header), SEEK_SET);
+        data = malloc((size_t)header.size);
+        if (data && (fread(data, 1, (size_t)header.size, f) != (size_t)header.size ||
+                     hashBytes(data, (size_t)header.size, HASH_SEED) != header.checksum))
+        {
+            printDebug(LOG_WARN, "Cache de fuente corrupta: %s. Se vuelve a hornear\n", path);
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+
+    if (data)
+        *size = (size_t)header.size;
+    return data;
+}
+
+bool FontCache_Save(const char *name, Uint64 key, const void *data, size_t size)
+{
+    if (!key || !data || !size)
+        return false;
+    if (!DirExists(CACHE_DIR))
+        mkdir(CACHE_DIR, 0755);
+
+    char path[256];
+    cachePath(path, sizeof(path), name);
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        printDebug(LOG_WARN, "No se pudo escribir la cache de fuente %s\n", path);
+        return false;
+    }
+
+    FontCacheHeader header = {FONTCACHE_MAGIC, FONTCACHE_VERSION, key, (Uint64)size, hashBytes(data, size, HASH_SEED)};
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 && fwrite(data, 1, size, f) == size;
+    if (fclose(f) != 0 || !ok)
+    {
+        printDebug(LOG_WARN, "No se pudo escribir la cache de fuente %s\n", path);
+        remove(path);
+        return false;
+    }
+    return true;
+}
@@ -19,6 +19,9 @@
 #define NK_SDL_RENDERER_IMPLEMENTATION
 
 #include "gui.h"
+#include "font.h"
+#include "screen.h"
+#include "tools.h"
 #include "nuklear_sdl_renderer.h"
 
 #pragma GCC diagnostic pop
@@ -30,55 +33,393 @@ static struct nk_context *ctx = NULL;
 static SDL_Renderer *sdl_renderer = NULL;
 static SDL_Window *sdl_window = NULL;
 
+// Arena de Nuklear: contexto, pool de ventanas y buffers salen de un solo
+// bloque reservado en GUI_Init. Es un bump
+// allocator: el ultimo bloque puede crecer en el lugar (nk_buffer_realloc
+// no copia si recibe el mismo puntero) y liberarlo devuelve su espacio;
+// los demas free no hacen nada. Si se llena se sigue con malloc.
+#define GUI_ARENA_ALIGN  16
+#define GUI_BUFFER_START 4096 // Tamano inicial de cada nk_buffer
+#define GUI_NO_BLOCK     ((size_t)-1)
+
+static Uint8 *arena       = NULL;
+static size_t arenaTop    = 0;
+static size_t arenaLast   = GUI_NO_BLOCK; // Inicio del ultimo bloque
+static GuiArenaStats arenaStats = {0};
+static struct nk_allocator allocator = {0};
+
+// Fuente del servicio de fuentes y su adaptador para Nuklear
+static Font *guiFont = NULL;
+static struct nk_user_font userFont;
+
+// Geometria convertida: se conserva entre frames y se reusa si los
+// comandos de Nuklear no cambiaron
+typedef struct {
+    SDL_Texture *texture;
+    SDL_Rect clip;
+    int offset;      // Primer indice en ebuf
+    int count;       // Indices del tramo
+} GuiBatch;
+
+static struct nk_buffer vbuf, ebuf;  // Vertices e indices (memoria persistente)
+static GuiBatch *batches = NULL;     // Comandos consecutivos con misma textura y clip, fusionados
+static int batchCount    = 0;
+static int batchCapacity = 0;
+static bool geometryValid = false;
+static Uint64 lastHash  = 0;         // Comandos de la geometria guardada
+static Uint64 frameHash = 0;         // Hash del frame actual (se calcula una vez)
+static bool frameHashed = false;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+static bool inArena(const void *ptr)
+{
+    return arena && (const Uint8 *)ptr >= arena && (const Uint8 *)ptr < arena + arenaStats.size;
+}
+
+static void *arenaAlloc(nk_handle unused, void *old, nk_size size)
+{
+    (void)unused;
+    size_t bytes = ((size_t)size + GUI_ARENA_ALIGN - 1) & ~(size_t)(GUI_ARENA_ALIGN - 1);
+
+    if (old && arenaLast != GUI_NO_BLOCK && old == arena + arenaLast && arenaLast + bytes <= arenaStats.size)
+        arenaTop = arenaLast + bytes; // Crece el ultimo bloque sin copiar
+    else if (arenaTop + bytes <= arenaStats.size)
+    {
+        arenaLast = arenaTop;
+        arenaTop += bytes;
+    }
+    else
+    {
+        if (arenaStats.overflow_allocs++ == 0)
+            printDebug(LOG_WARN, "Arena de GUI llena (%zu KB): se usa malloc. Subir [GUI] arena_kb\n", arenaStats.size / 1024);
+        arenaStats.overflow_bytes += bytes;
+        return malloc(bytes);
+    }
+
+    arenaStats.used = arenaTop;
+    if (arenaTop > arenaStats.peak)
+        arenaStats.peak = arenaTop;
+    return arena + arenaLast;
+}
+
+static void arenaFree(nk_handle unused, void *ptr)
+{
+    (void)unused;
+    if (!ptr)
+        return;
+    if (!inArena(ptr))
+    {
+        free(ptr);
+        return;
+    }
+    if (arenaLast != GUI_NO_BLOCK && ptr == arena + arenaLast)
+    {
+        arenaTop  = arenaLast;
+        arenaLast = GUI_NO_BLOCK;
+        arenaStats.used = arenaTop;
+    }
+}
+
+// Igual que nk_sdl_init() pero con el allocator de la arena (o el de
+// Nuklear si no hay arena).
+static struct nk_context *initContext(SDL_Window *win, SDL_Renderer *ren, size_t arenaBytes)
+{
+    arena = arenaBytes > 0 ? malloc(arenaBytes) : NULL;
+    if (arenaBytes > 0 && !arena)
+        printDebug(LOG_WARN, "No se pudo reservar la arena de GUI (%zu KB): se usa el heap\n", arenaBytes / 1024);
+    arenaStats = (GuiArenaStats){0};
+    arenaStats.size = arena ? arenaBytes : 0;
+    arenaTop  = 0;
+    arenaLast = GUI_NO_BLOCK;
+
+    if (arena)
+        allocator = (struct nk_allocator){nk_handle_ptr(NULL), arenaAlloc, arenaFree};
+    else
+        allocator = (struct nk_allocator){nk_handle_ptr(NULL), nk_malloc, nk_mfree};
+
+    sdl.win = win;
+    sdl.renderer = ren;
+    sdl.time_of_last_frame = SDL_GetTicks64();
+    if (!nk_init(&sdl.ctx, &allocator, NULL))
+        return NULL;
+    sdl.ctx.clip.copy = nk_sdl_clipboard_copy;
+    sdl.ctx.clip.paste = nk_sdl_clipboard_paste;
+    sdl.ctx.clip.userdata = nk_handle_ptr(0);
+    nk_buffer_init(&sdl.ogl.cmds, &allocator, GUI_BUFFER_START);
+    nk_buffer_init(&vbuf, &allocator, GUI_BUFFER_START);
+    nk_buffer_init(&ebuf, &allocator, GUI_BUFFER_START);
+    return &sdl.ctx;
+}
+
+// Ancho de un texto con los avances y el kerning del atlas compartido.
+static float fontWidth(nk_handle handle, float height, const char *text, int len)
+{
+    const Font *font = handle.ptr;
+    (void)height;
+
+    float width = 0.0f;
+    Uint32 prev = 0;
+    int offset = 0;
+    while (offset < len)
+    {
+        nk_rune rune = 0;
+        int n = nk_utf_decode(text + offset, &rune, len - offset);
+        if (!n)
+            break;
+        offset += n;
+
+        Uint32 cp = rune;
+        const FontGlyph *g = Font_Glyph(font, &cp);
+        width += (float)(Font_Kerning(font, prev, cp) + g->advance);
+        prev = cp;
+    }
+    return width;
+}
+
+// Quad de un glyph para nk_convert. Nuklear usa una sola textura por
+// fuente: los glyphs que cayeron fuera de la primera pagina solo avanzan.
+static void fontQuery(nk_handle handle, float height, struct nk_user_font_glyph *glyph, nk_rune codepoint, nk_rune next)
+{
+    const Font *font = handle.ptr;
+    (void)height;
+
+    Uint32 cp = codepoint, nextCp = next;
+    const FontGlyph *g = Font_Glyph(font, &cp);
+    if (nextCp)
+        Font_Glyph(font, &nextCp);
+
+    NK_MEMSET(glyph, 0, sizeof(*glyph));
+    glyph->xadvance = (float)(g->advance + (nextCp ? Font_Kerning(font, cp, nextCp) : 0));
+    if (g->page != 0)
+        return;
+    glyph->offset   = nk_vec2((float)g->offset_x, 0.0f);
+    glyph->width    = (float)g->src.w;
+    glyph->height   = (float)g->src.h;
+    glyph->uv[0]    = nk_vec2(g->u0, g->v0);
+    glyph->uv[1]    = nk_vec2(g->u1, g->v1);
+}
+
+// Usa la fuente del servicio (misma carga y atlas que el resto del motor).
+// Las formas se dibujan con el bloque blanco del atlas, asi texto y
+// formas comparten textura y los tramos se fusionan. Sin fuente se
+// hornea la default de Nuklear como hace el backend.
+static bool loadFont(const char *fontPath, float fontSize)
+{
+    guiFont = fontPath ? Font_Acquire(fontPath, (int)(fontSize + 0.5f)) : NULL;
+    if (!guiFont)
+    {
+        if (fontPath)
+            printDebug(LOG_WARN, "No se pudo cargar la fuente de GUI %s. Se usa la default\n", fontPath);
+        struct nk_font_atlas *atlas;
+        nk_sdl_font_stash_begin(&atlas);
+        nk_sdl_font_stash_end();
+        return sdl.atlas.default_font != NULL;
+    }
+
+    if (guiFont->page_count > 1)
+        printDebug(LOG_WARN, "La fuente de GUI ocupa %d paginas: solo se dibujan los glyphs de la primera\n", guiFont->page_count);
+
+    SDL_Texture *page = guiFont->pages[0];
+    userFont.userdata = nk_handle_ptr(guiFont);
+    userFont.height   = (float)guiFont->height;
+    userFont.width    = fontWidth;
+    userFont.query    = fontQuery;
+    userFont.texture  = nk_handle_ptr(page);
+
+    const FontGlyph *white = &guiFont->white;
+    if (white->page == 0)
+    {
+        sdl.ogl.tex_null.texture = nk_handle_ptr(page);
+        sdl.ogl.tex_null.uv = nk_vec2((white->u0 + white->u1) * 0.5f, (white->v0 + white->v1) * 0.5f);
+    }
+    else
+    {
+        // Sin textura SDL_RenderGeometry usa solo el color de los vertices
+        sdl.ogl.tex_null.texture = nk_handle_ptr(NULL);
+        sdl.ogl.tex_null.uv = nk_vec2(0.0f, 0.0f);
+    }
+
+    // El atlas propio queda vacio pero inicializado: nk_sdl_shutdown() lo limpia
+    nk_font_atlas_init_custom(&sdl.atlas, &allocator, &allocator);
+    nk_style_set_font(ctx, &userFont);
+    return true;
+}
+
+// Mismo criterio que nk_build() para saltear una ventana al dibujar.
+static bool windowDrawn(const struct nk_window *win)
+{
+    return win->buffer.begin != win->buffer.end && !(win->flags & NK_WINDOW_HIDDEN) && win->seq == ctx->seq;
+}
+
+// FNV-1a de la lista de comandos del frame: bytes de ctx->memory mas el
+// rango y orden de cada ventana dibujada (traer una ventana al frente no
+// cambia los bytes, solo el orden).
+static Uint64 commandHash(void)
+{
+    Uint64 h = hashBytes(nk_buffer_memory_const(&ctx->memory), ctx->memory.allocated, HASH_SEED);
+    for (const struct nk_window *win = ctx->begin; win; win = win->next)
+    {
+        if (!windowDrawn(win))
+            continue;
+        h = hashBytes(&win->buffer.begin, sizeof(win->buffer.begin), h);
+        h = hashBytes(&win->buffer.end, sizeof(win->buffer.end), h);
+    }
+    return h;
+}
+
+// El hash se calcula una sola vez por frame (GUI_Discard cierra el frame).
+static Uint64 frameCommandHash(void)
+{
+    if (!frameHashed)
+    {
+        frameHash = commandHash();
+        frameHashed = true;
+    }
+    return frameHash;
+}
+
+static bool pushBatch(SDL_Texture *texture, SDL_Rect clip, int offset, int count)
+{
+    if (batchCount > 0)
+    {
+        GuiBatch *last = &batches[batchCount - 1];
+        if (last->texture == texture && last->offset + last->count == offset &&
+            last->clip.x == clip.x && last->clip.y == clip.y && last->clip.w == clip.w && last->clip.h == clip.h)
+        {
+            last->count += count;
+            return true;
+        }
+    }
+    if (batchCount >= batchCapacity)
+    {
+        int cap = batchCapacity > 0 ? batchCapacity * 2 : 64;
+        GuiBatch *grown = realloc(batches, (size_t)cap * sizeof(GuiBatch));
+        if (!grown)
+            return false;
+        batches = grown;
+        batchCapacity = cap;
+    }
+    batches[batchCount++] = (GuiBatch){texture, clip, offset, count};
+    return true;
+}
+
+// nk_convert sobre los buffers persistentes y fusion de los comandos de
+// dibujo consecutivos que comparten textura y clip (indices contiguos).
+static bool convertCommands(void)
+{
+    static const struct nk_draw_vertex_layout_element vertexLayout[] = {
+        {NK_VERTEX_POSITION, NK_FORMAT_FLOAT, NK_OFFSETOF(struct nk_sdl_vertex, position)},
+        {NK_VERTEX_TEXCOORD, NK_FORMAT_FLOAT, NK_OFFSETOF(struct nk_sdl_vertex, uv)},
+        {NK_VERTEX_COLOR, NK_FORMAT_R8G8B8A8, NK_OFFSETOF(struct nk_sdl_vertex, col)},
+        {NK_VERTEX_LAYOUT_END}
+    };
+
+    struct nk_convert_config cfg;
+    NK_MEMSET(&cfg, 0, sizeof(cfg));
+    cfg.vertex_layout        = vertexLayout;
+    cfg.vertex_size          = sizeof(struct nk_sdl_vertex);
+    cfg.vertex_alignment     = NK_ALIGNOF(struct nk_sdl_vertex);
+    cfg.tex_null             = sdl.ogl.tex_null;
+    cfg.circle_segment_count = 22;
+    cfg.curve_segment_count  = 22;
+    cfg.arc_segment_count    = 22;
+    cfg.global_alpha         = 1.0f;
+    cfg.shape_AA             = NK_ANTI_ALIASING_ON;
+    cfg.line_AA              = NK_ANTI_ALIASING_ON;
+
+    nk_buffer_clear(&sdl.ogl.cmds);
+    nk_buffer_clear(&vbuf);
+    nk_buffer_clear(&ebuf);
+    batchCount = 0;
+    if (nk_convert(ctx, &sdl.ogl.cmds, &vbuf, &ebuf, &cfg) != NK_CONVERT_SUCCESS)
+        return false;
+
+    const struct nk_draw_command *cmd;
+    int offset = 0;
+    nk_draw_foreach(cmd, ctx, &sdl.ogl.cmds)
+    {
+        if (!cmd->elem_count)
+            continue;
+        SDL_Rect clip = {(int)cmd->clip_rect.x, (int)cmd->clip_rect.y, (int)cmd->clip_rect.w, (int)cmd->clip_rect.h};
+        if (!pushBatch((SDL_Texture *)cmd->texture.ptr, clip, offset, (int)cmd->elem_count))
+            return false;
+        offset += (int)cmd->elem_count;
+    }
+    return true;
+}
+
+// Dibuja la geometria guardada con el clip de cada tramo (restaura el clip del renderer).
+static void drawBatches(void)
+{
+    SDL_Rect savedClip;
+    SDL_bool clipping = SDL_RenderIsClipEnabled(sdl_renderer);
+    SDL_RenderGetClipRect(sdl_renderer, &savedClip);
+#ifdef NK_SDL_CLAMP_CLIP_RECT
+    SDL_Rect viewport;
+    SDL_RenderGetViewport(sdl_renderer, &viewport);
+#endif
+
+    int vs = sizeof(struct nk_sdl_vertex);
+    const nk_byte *vertices = nk_buffer_memory_const(&vbuf);
+    const nk_draw_index *indices = nk_buffer_memory_const(&ebuf);
+    int vertexCount = (int)(vbuf.needed / (nk_size)vs);
+
+    for (int i = 0; i < batchCount; i++)
+    {
+        SDL_Rect r = batches[i].clip;
+#ifdef NK_SDL_CLAMP_CLIP_RECT
+        if (r.x < 0) { r.w += r.x; r.x = 0; }
+        if (r.y < 0) { r.h += r.y; r.y = 0; }
+        if (r.h > viewport.h) r.h = viewport.h;
+        if (r.w > viewport.w) r.w = viewport.w;
+#endif
+        SDL_RenderSetClipRect(sdl_renderer, &r);
+        SDL_RenderGeometryRaw(sdl_renderer, batches[i].texture,
+                              (const float *)(vertices + offsetof(struct nk_sdl_vertex, position)), vs,
+                              (const SDL_Color *)(vertices + offsetof(struct nk_sdl_vertex, col)), vs,
+                              (const float *)(vertices + offsetof(struct nk_sdl_vertex, uv)), vs,
+                              vertexCount, indices + batches[i].offset, batches[i].count, sizeof(nk_draw_index));
+    }
+
+    SDL_RenderSetClipRect(sdl_renderer, clipping ? &savedClip : NULL);
+}
+
 // ============================================================
 // Funciones publicas
 // ============================================================
 
-/// Inicializa Nuklear con el renderer SDL y carga la fuente TTF indicada.
-bool GUI_Init(SDL_Window *win, SDL_Renderer *ren, const char *font_path, float font_size)
+/// Inicializa Nuklear con el renderer SDL y pide la fuente TTF indicada
+/// al servicio de fuentes (comparte carga y atlas con el resto del motor).
+bool GUI_Init(SDL_Window *win, SDL_Renderer *ren, const char *font_path, float font_size, int arena_kb)
 {
     sdl_window = win;
     sdl_renderer = ren;
-    ctx = nk_sdl_init(win, ren);
+    ctx = initContext(win, ren, arena_kb > 0 ? (size_t)arena_kb * 1024 : 0);
     if (!ctx)
         return false;
-
-    struct nk_font_atlas *atlas;
-    struct nk_font *nk_font = NULL;
-    nk_sdl_font_stash_begin(&atlas);
-    if (font_path)
-        nk_font = nk_font_atlas_add_from_file(atlas, font_path, font_size, 0);
-    nk_sdl_font_stash_end();
-
-    if (nk_font)
-        nk_style_set_font(ctx, &nk_font->handle);
-
-    return true;
+    return loadFont(font_path, font_size);
 }
 
 /// Delega el evento SDL al backend de entrada de Nuklear.
 /// Transforma coordenadas de mouse de espacio de ventana a espacio logico
-/// para que Nuklear funcione correctamente con SDL_RenderSetScale.
+/// (escala del render o target logico con bandas, ver screen.h).
 int GUI_HandleEvent(SDL_Event *event)
 {
-    float sx, sy;
-    SDL_RenderGetScale(sdl_renderer, &sx, &sy);
-
     switch (event->type)
     {
         case SDL_MOUSEBUTTONDOWN:
         case SDL_MOUSEBUTTONUP:
         {
-            event->button.x = (int)(event->button.x / sx);
-            event->button.y = (int)(event->button.y / sy);
+            Screen_WindowToLogical(&event->button.x, &event->button.y);
             break;
         }
         case SDL_MOUSEMOTION:
         {
-            event->motion.x = (int)(event->motion.x / sx);
-            event->motion.y = (int)(event->motion.y / sy);
-            event->motion.xrel = (int)(event->motion.xrel / sx);
-            event->motion.yrel = (int)(event->motion.yrel / sy);
+            Screen_WindowToLogical(&event->motion.x, &event->motion.y);
+            Screen_WindowDeltaToLogical(&event->motion.xrel, &event->motion.yrel);
             break;
         }
     }
@@ -98,20 +439,76 @@ void GUI_InputEnd(void)
 }
 
 /// Renderiza los comandos de dibujo acumulados con anti-aliasing activado.
+/// Reemplaza a nk_sdl_render(): los buffers de vertices e indices se
+/// conservan entre frames y, si los comandos son los mismos que en el
+/// frame anterior, se redibuja la geometria ya convertida sin nk_convert.
 void GUI_Render(void)
 {
-    nk_sdl_render(NK_ANTI_ALIASING_ON);
+    Uint64 hash = frameCommandHash();
+    if (!geometryValid || hash != lastHash)
+    {
+        geometryValid = convertCommands();
+        lastHash = hash;
+    }
+    if (geometryValid)
+        drawBatches();
+    GUI_Discard();
+}
+
+/// Compara los comandos del frame contra los del ultimo GUI_Render().
+bool GUI_Changed(void)
+{
+    return !geometryValid || frameCommandHash() != lastHash;
+}
+
+/// Indica si ninguna ventana dibuja algo este frame.
+bool GUI_IsEmpty(void)
+{
+    for (const struct nk_window *win = ctx->begin; win; win = win->next)
+        if (windowDrawn(win))
+            return false;
+    return true;
+}
+
+/// Cierra el frame de Nuklear sin convertir (la capa ya esta en cache).
+/// Avanza el reloj del backend igual que nk_sdl_render().
+void GUI_Discard(void)
+{
+    Uint64 now = SDL_GetTicks64();
+    ctx->delta_time_seconds = (float)(now - sdl.time_of_last_frame) / 1000;
+    sdl.time_of_last_frame = now;
+    nk_clear(ctx);
+    frameHashed = false;
 }
 
 /// Libera los recursos de Nuklear y resetea los punteros internos.
 void GUI_Destroy(void)
 {
+    nk_buffer_free(&vbuf);
+    nk_buffer_free(&ebuf);
     nk_sdl_shutdown();
+    Font_Release(guiFont);
+    guiFont = NULL;
+    free(arena);
+    arena = NULL;
+    arenaStats = (GuiArenaStats){0};
+    free(batches);
+    batches = NULL;
+    batchCount = batchCapacity = 0;
+    geometryValid = false;
+    frameHashed = false;
+    lastHash = 0;
     ctx = NULL;
     sdl_renderer = NULL;
     sdl_window = NULL;
 }
 
+/// Devuelve el uso de la arena de Nuklear.
+GuiArenaStats GUI_GetArenaStats(void)
+{
+    return arenaStats;
+}
+
 /// Devuelve el contexto Nuklear activo (o NULL si no esta inicializado).
 struct nk_context* GUI_GetContext(void)
 {
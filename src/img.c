@@ -7,6 +7,9 @@
 // Includes
 // ============================================================
 #include "img.h"
+#include "atlas.h"
+#include "jobs.h"
+#include "pack.h"
 #include "engine.h"
 #include "tools.h"
 #include <stdio.h>
@@ -20,6 +23,56 @@
 
 static const char *imageExtensions[] = {".png", ".jpg", ".jpeg", ".bmp"}; // Extensiones validas
 
+// Job de decodificacion de initTextureLib (una imagen).
+typedef struct {
+    const char  *dir;
+    const char  *name;
+    Uint32       format;     // Formato destino (el de las paginas del atlas)
+    SDL_Surface *surface;    // Resultado (NULL si fallo)
+    double       decode_ms;  // IMG_Load
+    double       convert_ms; // Conversion al formato destino
+    char         error[256]; // Error del worker (vacio si no hubo), se informa en el hilo principal
+} DecodeJob;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Decodifica y convierte una imagen. Corre en un worker: no toca el renderer
+// ni llama a printDebug (no es reentrante), el error queda en el job.
+// Si la imagen esta en el paquete de assets sus pixeles ya vienen decodificados.
+static void decodeImageJob(void *data)
+{
+	DecodeJob *job = data;
+	double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+	char image_path[strlen(job->dir) + strlen(job->name) + 1];
+	snprintf(image_path, sizeof(image_path), "%s%s", job->dir, job->name);
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	SDL_Surface *srf = Pack_CreateSurface(Pack_Find(image_path));
+	if(!srf)
+		srf = IMG_Load(image_path);
+	Uint64 decoded = SDL_GetPerformanceCounter();
+	job->decode_ms = (double)(decoded - start) * msPerTick;
+	if(!srf)
+	{
+		snprintf(job->error, sizeof(job->error), "No se pudo cargar la imagen '%s': %s", job->name, IMG_GetError());
+		return;
+	}
+
+	if(srf->format->format != job->format)
+	{
+		SDL_Surface *conv = SDL_ConvertSurfaceFormat(srf, job->format, 0);
+		SDL_FreeSurface(srf);
+		srf = conv;
+		if(!srf)
+			snprintf(job->error, sizeof(job->error), "No se pudo convertir la imagen '%s': %s", job->name, SDL_GetError());
+	}
+	job->convert_ms = (double)(SDL_GetPerformanceCounter() - decoded) * msPerTick;
+	job->surface = srf;
+}
+
 // ============================================================
 // Inicializacion y cierre
 // ============================================================
@@ -46,83 +99,160 @@ void quitTexture(void)
 // Gestion de librerias de texturas
 // ============================================================
 
-// Carga todas las imagenes de un directorio.
-// Cada imagen se convierte en una SDL_Texture con su SDL_Rect asociado.
+// Carga todas las imagenes de un directorio y las empaqueta en paginas de atlas.
+// textures_array[i] apunta a la pagina de la imagen i y rects[i] a su region.
+// La decodificacion (IMG_Load + conversion de formato) corre en el sistema de
+// jobs; el hilo principal solo compone y sube las paginas. Con un solo
+// worker los jobs se ejecutan en serie.
 texture initTextureLib(char *path)
 {
 	texture current = {0};
 	int n = 0;
 
-	char **textures_array = getFilesFromDir(path, &n, imageExtensions, ARRAY_L(imageExtensions), IMAGE);
+	char **textures_array = Pack_ListDir(path, PACK_IMAGE, &n);
+	if(!textures_array)
+		textures_array = getFilesFromDir(path, &n, imageExtensions, ARRAY_L(imageExtensions), IMAGE);
 	if(!textures_array || n <= 0)
 	{
 		printDebug(LOG_ERROR, "No se pudo crear la libreria de texturas en '%s'\n", path);
 		return current;
 	}
 
-	current.textures_array = malloc(n * sizeof(SDL_Texture *));
-	current.rects = malloc(n * sizeof(SDL_Rect *));
-	if(!current.textures_array)
+	DecodeJob *jobs = calloc(n, sizeof(DecodeJob));
+	SDL_Surface **surfaces = calloc(n, sizeof(SDL_Surface *));
+	int *pageOf = calloc(n, sizeof(int));
+	SDL_Rect *packed = calloc(n, sizeof(SDL_Rect));
+	current.textures_array = calloc(n, sizeof(SDL_Texture *));
+	current.rects = calloc(n, sizeof(SDL_Rect *));
+	if(!jobs || !surfaces || !pageOf || !packed || !current.textures_array || !current.rects)
 	{
 		printDebug(LOG_WARN, "No se pudo asignar memoria para texturas\n");
+		free(jobs);
+		free(surfaces);
+		free(pageOf);
+		free(packed);
+		freeTextureLib(&current);
 		freeStringArray(textures_array, n);
 		return current;
 	}
-	if(!current.rects)
+	current.names = textures_array;
+	current.n = n;
+
+	// 1) Workers: decodificar y convertir al formato de las paginas
+	double msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+	Uint64 start = SDL_GetPerformanceCounter();
+	Uint32 format = Atlas_PixelFormat();
+	JobCounter decoded = {0};
+	for (int i = 0; i < n; i++)
 	{
-		printDebug(LOG_WARN, "No se pudo asignar memoria para rectangulos\n");
-		freeStringArray(textures_array, n);
-		return current;
+		jobs[i] = (DecodeJob){.dir = path, .name = textures_array[i], .format = format};
+		Jobs_Run(decodeImageJob, &jobs[i], &decoded);
 	}
-	current.n = n;
+	Jobs_Wait(&decoded);
+	Uint64 decodeEnd = SDL_GetPerformanceCounter();
 
+	bool ok = true;
 	for (int i = 0; i < n; i++)
 	{
-		// Construir ruta completa: directorio + nombre de archivo
-		char image_path[strlen(path) + strlen(textures_array[i]) + 1];
-		snprintf(image_path, sizeof(image_path), "%s%s", path, textures_array[i]);
-		SDL_Surface *srf = IMG_Load(image_path);
-		if(!srf)
-		{
-			printDebug(LOG_WARN, "No se pudo cargar la imagen '%s'\n", textures_array[i]);
-			freeTextureLib(&current);
-			break;
-		}
-		current.textures_array[i] = SDL_CreateTextureFromSurface(render, srf);
+		surfaces[i] = jobs[i].surface;
+		if(jobs[i].error[0])
+			printDebug(LOG_WARN, "%s\n", jobs[i].error);
+		if(!surfaces[i])
+			ok = false;
+		else
+			printDebug(LOG_INFO, "  '%s': decode %.2f ms, conversion %.2f ms\n", jobs[i].name, jobs[i].decode_ms, jobs[i].convert_ms);
+	}
+
+	// 2) Hilo principal: empaquetar y subir las paginas
+	if(ok)
+	{
+		current.page_count = Atlas_Build(surfaces, n, ATLAS_PAGE_SIZE, ATLAS_PADDING, &current.pages, pageOf, packed);
+		ok = current.page_count > 0;
+	}
+
+	for (int i = 0; i < n && ok; i++)
+	{
+		current.textures_array[i] = current.pages[pageOf[i]];
 		current.rects[i] = malloc(sizeof(SDL_Rect));
 		if(!current.rects[i])
 		{
 			printDebug(LOG_WARN, "No se pudo asignar memoria para el rectangulo %d\n", i);
-			SDL_FreeSurface(srf);
-			freeTextureLib(&current);
+			ok = false;
 			break;
 		}
-		assignRectToTexture(current.textures_array[i], current.rects[i]);
-		SDL_FreeSurface(srf);
+		*current.rects[i] = packed[i];
+	}
+
+	for (int i = 0; i < n; i++)
+	{
+		if(surfaces[i])
+			SDL_FreeSurface(surfaces[i]);
 	}
-	freeStringArray(textures_array, n);
+	free(jobs);
+	free(surfaces);
+	free(pageOf);
+	free(packed);
+
+	if(!ok)
+		freeTextureLib(&current);
+	else
+		printDebug(LOG_INFO, "Libreria '%s': %d imagenes en %d paginas (decode %.2f ms con %d workers, atlas %.2f ms)\n",
+		           path, current.n, current.page_count, (double)(decodeEnd - start) * msPerTick,
+		           Jobs_WorkerCount(), (double)(SDL_GetPerformanceCounter() - decodeEnd) * msPerTick);
 	return current;
 }
 
-// Libera texturas, rectangulos y resetea el contador.
+// Libera paginas, rectangulos y nombres, y resetea el contador.
+// Las entradas de textures_array son alias de las paginas: no se destruyen aparte.
 void freeTextureLib(texture *txr)
 {
 	if(!txr)
 		return;
 	for(int i = 0; i < txr->n; i++)
 	{
-		if(txr->textures_array && txr->textures_array[i])
-			SDL_DestroyTexture(txr->textures_array[i]);
 		if(txr->rects && txr->rects[i])
 			free(txr->rects[i]);
 	}
+	if(txr->names)
+		freeStringArray(txr->names, txr->n);
+	Atlas_FreePages(txr->pages, txr->page_count);
 	free(txr->textures_array);
 	free(txr->rects);
 	txr->textures_array = NULL;
 	txr->rects = NULL;
+	txr->names = NULL;
+	txr->pages = NULL;
+	txr->page_count = 0;
 	txr->n = 0;
 }
 
+// Busca una imagen por nombre de archivo. Retorna -1 si no esta en la libreria.
+int findTexture(const texture *txr, const char *name)
+{
+	if(!txr || !txr->names || !name)
+		return -1;
+	for(int i = 0; i < txr->n; i++)
+	{
+		if(txr->names[i] && !strcmp(txr->names[i], name))
+			return i;
+	}
+	return -1;
+}
+
+// Arma la region (pagina + sub-rect) de la imagen 'index'.
+TextureRegion getTextureRegion(const texture *txr, int index)
+{
+	if(!txr || index < 0 || index >= txr->n || !txr->rects || !txr->rects[index])
+	{
+		printDebug(LOG_WARN, "Region de textura invalida (indice %d)\n", index);
+		return (TextureRegion){0};
+	}
+	return (TextureRegion){
+		.texture = txr->textures_array[index],
+		.src     = *txr->rects[index]
+	};
+}
+
 // ============================================================
 // Utilidades de textura
 // ============================================================
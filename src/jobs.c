@@ -0,0 +1,384 @@
+/**
+ * @file jobs.c
+ * @brief Implementacion del sistema de jobs con work-stealing.
+ *
+ * Cada cola es un buffer circular protegido por un SDL_SpinLock (las
+ * secciones criticas son de unas pocas instrucciones). Los workers sin
+ * trabajo duermen en una variable de condicion; Jobs_Run solo la
+ * senhala si hay alguien durmiendo.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#define _POSIX_C_SOURCE 200809L
+#include <sched.h>
+
+#include "jobs.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define JOBS_MAX_WORKERS 64
+#define JOBS_DEQUE_SIZE  1024 // Potencia de 2 (indices con mascara)
+#define JOBS_MAX_RANGES  256  // Rangos maximos por Jobs_ParallelFor
+
+typedef struct {
+    JobFunc     fn;
+    void       *data;
+    JobCounter *counter;    // Se decrementa al terminar (puede ser NULL)
+    JobCounter *dependency; // Debe llegar a cero antes de ejecutar (puede ser NULL)
+} Job;
+
+typedef struct {
+    Job          jobs[JOBS_DEQUE_SIZE];
+    unsigned     head; // Siguiente job a robar (FIFO)
+    unsigned     tail; // Siguiente posicion libre del dueno (LIFO)
+    SDL_SpinLock lock;
+} JobDeque;
+
+typedef struct {
+    JobRangeFunc fn;
+    void        *data;
+    int          start;
+    int          end;
+} RangeJob;
+
+static JobDeque   *deques      = NULL;
+static SDL_Thread *threads[JOBS_MAX_WORKERS] = {0};
+static int         workerCount = 1;
+static bool        initialized = false;
+
+static SDL_atomic_t running;  // 0 = los workers deben salir
+static SDL_atomic_t queued;   // Jobs en todas las colas
+static SDL_atomic_t sleeping; // Workers esperando en wakeCond
+static SDL_mutex   *sleepLock = NULL;
+static SDL_cond    *wakeCond  = NULL;
+
+static _Thread_local int workerIndex = 0; // 0 = hilo principal
+
+// ============================================================
+// Colas (static)
+// ============================================================
+
+// Apila un job. front = true lo pone del lado de los ladrones (sale ultimo para el dueno).
+static bool dequePush(JobDeque *d, const Job *job, bool front)
+{
+    bool ok = false;
+    SDL_AtomicLock(&d->lock);
+    if (d->tail - d->head < JOBS_DEQUE_SIZE)
+    {
+        if (front)
+            d->jobs[--d->head & (JOBS_DEQUE_SIZE - 1)] = *job;
+        else
+            d->jobs[d->tail++ & (JOBS_DEQUE_SIZE - 1)] = *job;
+        ok = true;
+    }
+    SDL_AtomicUnlock(&d->lock);
+    return ok;
+}
+
+// El dueno toma el job mas reciente.
+static bool dequePop(JobDeque *d, Job *out)
+{
+    bool ok = false;
+    SDL_AtomicLock(&d->lock);
+    if (d->tail != d->head)
+    {
+        *out = d->jobs[--d->tail & (JOBS_DEQUE_SIZE - 1)];
+        ok = true;
+    }
+    SDL_AtomicUnlock(&d->lock);
+    return ok;
+}
+
+// Otro worker roba el job mas antiguo.
+static bool dequeSteal(JobDeque *d, Job *out)
+{
+    bool ok = false;
+    SDL_AtomicLock(&d->lock);
+    if (d->tail != d->head)
+    {
+        *out = d->jobs[d->head++ & (JOBS_DEQUE_SIZE - 1)];
+        ok = true;
+    }
+    SDL_AtomicUnlock(&d->lock);
+    return ok;
+}
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Encola en la cola del hilo actual y despierta a un worker dormido.
+static bool pushJob(const Job *job, bool front)
+{
+    SDL_AtomicAdd(&queued, 1);
+    if (!dequePush(&deques[workerIndex], job, front))
+    {
+        SDL_AtomicAdd(&queued, -1);
+        return false;
+    }
+
+    if (SDL_AtomicGet(&sleeping) > 0)
+    {
+        SDL_LockMutex(sleepLock);
+        SDL_CondSignal(wakeCond);
+        SDL_UnlockMutex(sleepLock);
+    }
+    return true;
+}
+
+// Toma un job de la cola propia o, si esta vacia, lo roba de otra.
+static bool takeJob(Job *out)
+{
+    bool ok = dequePop(&deques[workerIndex], out);
+    for (int i = 1; !ok && i < workerCount; i++)
+        ok = dequeSteal(&deques[(workerIndex + i) % workerCount], out);
+
+    if (ok)
+        SDL_AtomicAdd(&queued, -1);
+    return ok;
+}
+
+// Ejecuta un job pendiente. Retorna false si no habia trabajo listo.
+static bool runOneJob(void)
+{
+    Job job;
+    if (!initialized || !takeJob(&job))
+        return false;
+
+    // Dependencia sin resolver: devolverlo a la cola para que salga despues
+    if (job.dependency && SDL_AtomicGet(&job.dependency->pending) > 0)
+    {
+        if (pushJob(&job, true))
+            return false;
+        // Cola llena: esperar la dependencia aqui mismo
+        Jobs_Wait(job.dependency);
+    }
+
+    job.fn(job.data);
+    if (job.counter)
+        SDL_AtomicAdd(&job.counter->pending, -1);
+    return true;
+}
+
+// Bucle de cada hilo worker.
+static int workerMain(void *arg)
+{
+    workerIndex = (int)(intptr_t)arg;
+
+    while (SDL_AtomicGet(&running))
+    {
+        if (runOneJob())
+            continue;
+
+        // Hay jobs esperando una dependencia: ceder la CPU sin dormir
+        if (SDL_AtomicGet(&queued) > 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        SDL_LockMutex(sleepLock);
+        SDL_AtomicAdd(&sleeping, 1);
+        while (SDL_AtomicGet(&running) && SDL_AtomicGet(&queued) <= 0)
+            SDL_CondWait(wakeCond, sleepLock);
+        SDL_AtomicAdd(&sleeping, -1);
+        SDL_UnlockMutex(sleepLock);
+    }
+    return 0;
+}
+
+// Procesa un rango de Jobs_ParallelFor.
+static void runRange(void *arg)
+{
+    RangeJob *r = arg;
+    r->fn(r->start, r->end, r->data);
+}
+
+// ============================================================
+// Inicializacion y cierre
+// ============================================================
+
+// Reserva las colas y lanza workers-1 hilos (el principal es el worker 0).
+bool Jobs_Init(int workers)
+{
+    if (initialized)
+        Jobs_Quit();
+
+    if (workers <= 0)
+        workers = SDL_GetCPUCount();
+    if (workers < 1)
+        workers = 1;
+    if (workers > JOBS_MAX_WORKERS)
+        workers = JOBS_MAX_WORKERS;
+
+    deques    = calloc((size_t)workers, sizeof(JobDeque));
+    sleepLock = SDL_CreateMutex();
+    wakeCond  = SDL_CreateCond();
+    if (!deques || !sleepLock || !wakeCond)
+    {
+        printDebug(LOG_ERROR, "No se pudo iniciar el sistema de jobs: %s\n", SDL_GetError());
+        Jobs_Quit();
+        return false;
+    }
+
+    SDL_AtomicSet(&running, 1);
+    SDL_AtomicSet(&queued, 0);
+    SDL_AtomicSet(&sleeping, 0);
+    workerIndex = 0;
+    workerCount = workers;
+    initialized = true;
+
+    for (int i = 1; i < workers; i++)
+    {
+        char name[16];
+        snprintf(name, sizeof(name), "worker%d", i);
+        threads[i] = SDL_CreateThread(workerMain, name, (void *)(intptr_t)i);
+        if (!threads[i])
+        {
+            printDebug(LOG_ERROR, "No se pudo crear el hilo '%s': %s\n", name, SDL_GetError());
+            Jobs_Quit();
+            return false;
+        }
+    }
+
+    printDebug(LOG_INFO, "Sistema de jobs iniciado con %d workers\n", workerCount);
+    return true;
+}
+
+// Detiene los workers, vacia las colas en el hilo principal y libera todo.
+void Jobs_Quit(void)
+{
+    if (initialized)
+    {
+        SDL_AtomicSet(&running, 0);
+        SDL_LockMutex(sleepLock);
+        SDL_CondBroadcast(wakeCond);
+        SDL_UnlockMutex(sleepLock);
+
+        for (int i = 1; i < workerCount; i++)
+        {
+            if (threads[i])
+                SDL_WaitThread(threads[i], NULL);
+            threads[i] = NULL;
+        }
+
+        // Lo que quedo encolado se ejecuta aqui (ya sin otros hilos)
+        workerCount = 1;
+        for (int i = 0; SDL_AtomicGet(&queued) > 0; )
+        {
+            Job job;
+            if (dequeSteal(&deques[i], &job))
+            {
+                SDL_AtomicAdd(&queued, -1);
+                job.fn(job.data);
+                if (job.counter)
+                    SDL_AtomicAdd(&job.counter->pending, -1);
+            }
+            else
+                i++;
+        }
+    }
+
+    if (wakeCond)
+        SDL_DestroyCond(wakeCond);
+    if (sleepLock)
+        SDL_DestroyMutex(sleepLock);
+    free(deques);
+    wakeCond    = NULL;
+    sleepLock   = NULL;
+    deques      = NULL;
+    workerCount = 1;
+    initialized = false;
+}
+
+// Devuelve la cantidad de workers (1 si el sistema no esta iniciado).
+int Jobs_WorkerCount(void)
+{
+    return initialized ? workerCount : 1;
+}
+
+// ============================================================
+// Encolado y espera
+// ============================================================
+
+// Encola un job sin dependencias.
+void Jobs_Run(JobFunc fn, void *data, JobCounter *counter)
+{
+    Jobs_RunAfter(NULL, fn, data, counter);
+}
+
+// Encola un job que espera a 'dependency'. Sin workers se ejecuta en linea.
+void Jobs_RunAfter(JobCounter *dependency, JobFunc fn, void *data, JobCounter *counter)
+{
+    if (!fn)
+        return;
+
+    Job job = {fn, data, counter, dependency};
+    if (counter)
+        SDL_AtomicAdd(&counter->pending, 1);
+
+    if (initialized && workerCount > 1 && pushJob(&job, false))
+        return;
+
+    // Serie (o cola llena): ejecutar ahora mismo
+    if (dependency)
+        Jobs_Wait(dependency);
+    fn(data);
+    if (counter)
+        SDL_AtomicAdd(&counter->pending, -1);
+}
+
+// Ayuda a vaciar las colas mientras el contador no llegue a cero.
+void Jobs_Wait(JobCounter *counter)
+{
+    if (!counter)
+        return;
+    while (SDL_AtomicGet(&counter->pending) > 0)
+    {
+        if (!runOneJob())
+            sched_yield();
+    }
+}
+
+// Divide [0, count) en ~4 rangos por worker (minimo minBatch elementos cada uno).
+void Jobs_ParallelFor(int count, int minBatch, JobRangeFunc fn, void *data)
+{
+    if (!fn || count <= 0)
+        return;
+    if (minBatch < 1)
+        minBatch = 1;
+
+    int workers = Jobs_WorkerCount();
+    if (workers <= 1 || count <= minBatch)
+    {
+        fn(0, count, data);
+        return;
+    }
+
+    int ranges = workers * 4;
+    if (ranges > JOBS_MAX_RANGES)
+        ranges = JOBS_MAX_RANGES;
+    int size = (count + ranges - 1) / ranges;
+    if (size < minBatch)
+        size = minBatch;
+    ranges = (count + size - 1) / size;
+
+    RangeJob jobs[JOBS_MAX_RANGES];
+    JobCounter counter = {0};
+    for (int i = 0; i < ranges; i++)
+    {
+        int end = (i + 1) * size;
+        jobs[i] = (RangeJob){fn, data, i * size, end < count ? end : count};
+    }
+
+    // El primer rango lo procesa el hilo que llama
+    for (int i = 1; i < ranges; i++)
+        Jobs_Run(runRange, &jobs[i], &counter);
+    runRange(&jobs[0]);
+    Jobs_Wait(&counter);
+}
@@ -1,4 +1,5 @@
 #include "jsonHandler.h"
+#include "pack.h"
 #include "tools.h"
 #include <cjson/cJSON.h>
 #include <stdio.h>
@@ -10,22 +11,31 @@ bool readASpriteFromJSON(const char *jsonFileName)
     // Fase 1: Sacar la informacion del archivo como un string largo:
     static char path[256];
     snprintf(path, sizeof(path), "%s%s", JSON_SPRITE_DIR, jsonFileName);
-    FILE *spriteJsonFile = fopen(path, "r");
-    if (!spriteJsonFile)
+    // Desde el paquete de assets se parsea directo sobre la memoria mapeada
+    const PackEntry *entry = Pack_Find(path);
+    const char *text = Pack_Data(entry);
+    size_t textSize = entry ? (size_t)entry->size : 0;
+    char *buffer = NULL;
+    if (!entry)
     {
-        printDebug(LOG_ERROR, "Error al abrir archivo '%s', ruta completa: '%s'\n", jsonFileName, path);
-        return false;
+        FILE *spriteJsonFile = fopen(path, "r");
+        if (!spriteJsonFile)
+        {
+            printDebug(LOG_ERROR, "Error al abrir archivo '%s', ruta completa: '%s'\n", jsonFileName, path);
+            return false;
+        }
+        long int jsonFileSize = fileSize(spriteJsonFile);
+        buffer = malloc((size_t)jsonFileSize + sizeof(char));
+        textSize = fread(buffer, 1, (size_t)jsonFileSize, spriteJsonFile);
+        buffer[textSize] = '\0';
+        fclose(spriteJsonFile);
+        text = buffer;
     }
-    long int jsonFileSize = fileSize(spriteJsonFile);
-    char *buffer = malloc((size_t)jsonFileSize + sizeof(char));
-    fread(buffer, 1, (size_t)jsonFileSize, spriteJsonFile);
-    buffer[jsonFileSize] = '\0';
-    fclose(spriteJsonFile);
 
     printDebug(LOG_INFO, "Fase 1: Completa\n");
 
     // Fase 2: Parsear con cJSON
-    cJSON *jsonFile = cJSON_Parse(buffer);
+    cJSON *jsonFile = cJSON_ParseWithLength(text, textSize);
     if(!jsonFile)
     {
         const char *errorString = cJSON_GetErrorPtr();
@@ -0,0 +1,521 @@
+/**
+ * @file mixer.c
+ * @brief Implementacion del mezclador por software.
+ *
+ * La cola de comandos tiene un solo productor (hilo del juego) y un solo
+ * consumidor (hilo de audio): cada lado avanza solo su indice y lo
+ * publica con una barrera, sin locks. Las voces activas estan compactas
+ * al principio del array (al terminar una se mueve la ultima a su lugar),
+ * asi la mezcla recorre solo las que suenan.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "mixer.h"
+#include "tools.h"
+
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIXER_HAS_SSE2 1
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MIXER_HAS_AVX2 1
+#define MIXER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define MIXER_FRAME_BYTES (2 * (int)sizeof(Sint16)) // S16 estereo
+
+typedef enum {
+    MIXER_CMD_PLAY,
+    MIXER_CMD_STOP,
+    MIXER_CMD_GAIN
+} MixerCommandType;
+
+typedef struct {
+    MixerCommandType type;
+    int id;
+    const Sint16 *samples; // PLAY: muestras intercaladas L/R
+    Uint32 frames;         // PLAY: largo en frames
+    float gain;            // PLAY / GAIN
+    float pan;             // PLAY
+} MixerCommand;
+
+typedef struct {
+    int id;
+    const Sint16 *samples;
+    Uint32 frames;
+    Uint32 pos;            // Siguiente frame a mezclar
+    Uint32 serial;         // Orden de inicio (para robar la mas vieja)
+    float gain;            // Ganancia pedida (sin paneo)
+    float pan;
+    float gain_l, gain_r;  // Ganancia final por canal
+} MixerVoice;
+
+// Kernels: acumular una voz en float y volver el bloque a S16.
+typedef void (*MixerAccumulate)(float *acc, const Sint16 *src, int frames, float gl, float gr);
+typedef void (*MixerResolve)(Sint16 *stream, const float *acc, int samples);
+
+typedef struct {
+    MixerAccumulate accumulate;
+    MixerResolve resolve;
+} MixerOps;
+
+static MixerVoice *voices     = NULL; // Solo el hilo de audio (o el juego con el audio detenido)
+static int         voiceCount = 0;
+static int         active     = 0;    // Voces en uso al principio de 'voices'
+static bool        attached   = false;
+static MixerKernel kernel     = MIXER_KERNEL_SCALAR;
+static int         nextId     = 1;    // Solo el hilo del juego
+static int         droppedCommands = 0;
+
+static MixerCommand ring[MIXER_RING_SIZE];
+static SDL_atomic_t ringHead;     // Siguiente comando a aplicar (consumidor)
+static SDL_atomic_t ringTail;     // Siguiente posicion libre (productor)
+static SDL_atomic_t activeShared; // 'active' publicado para las estadisticas
+static SDL_atomic_t stolenVoices;
+static Uint32       playSerial = 0; // Solo el hilo de audio
+
+static _Alignas(32) float mixBlock[MIXER_BLOCK * 2]; // Acumulador L/R de un bloque
+
+// ============================================================
+// Kernels (static)
+// ============================================================
+
+static void accumulateScalar(float *acc, const Sint16 *src, int frames, float gl, float gr)
+{
+    for (int i = 0; i < frames; i++)
+    {
+        acc[2 * i]     += (float)src[2 * i] * gl;
+        acc[2 * i + 1] += (float)src[2 * i + 1] * gr;
+    }
+}
+
+// stream + acc, redondeado y saturado a S16.
+static void resolveScalar(Sint16 *stream, const float *acc, int samples)
+{
+    for (int i = 0; i < samples; i++)
+    {
+        float v = (float)stream[i] + acc[i];
+        if (v >= 32767.0f)
+            stream[i] = 32767;
+        else if (v <= -32768.0f)
+            stream[i] = -32768;
+        else
+            stream[i] = (Sint16)(v + (v >= 0.0f ? 0.5f : -0.5f));
+    }
+}
+
+#ifdef MIXER_HAS_SSE2
+// 4 frames por vuelta: los 8 Sint16 se extienden a int32 y se escalan por (gl, gr, gl, gr).
+static void accumulateSSE2(float *acc, const Sint16 *src, int frames, float gl, float gr)
+{
+    const __m128 gain = _mm_setr_ps(gl, gr, gl, gr);
+    int i = 0;
+    for (; i + 4 <= frames; i += 4)
+    {
+        __m128i s  = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        float *a = acc + 2 * i;
+        _mm_storeu_ps(a,     _mm_add_ps(_mm_loadu_ps(a),     _mm_mul_ps(_mm_cvtepi32_ps(lo), gain)));
+        _mm_storeu_ps(a + 4, _mm_add_ps(_mm_loadu_ps(a + 4), _mm_mul_ps(_mm_cvtepi32_ps(hi), gain)));
+    }
+    accumulateScalar(acc + 2 * i, src + 2 * i, frames - i, gl, gr);
+}
+
+// 8 muestras por vuelta. Se satura en float antes de convertir: fuera de
+// +-2^31 cvtps da INT_MIN y un pico positivo saldria a -32768.
+static void resolveSSE2(Sint16 *stream, const float *acc, int samples)
+{
+    const __m128 lowest  = _mm_set1_ps(-32768.0f);
+    const __m128 highest = _mm_set1_ps(32767.0f);
+    int i = 0;
+    for (; i + 8 <= samples; i += 8)
+    {
+        __m128i s  = _mm_loadu_si128((const __m128i *)(stream + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        __m128 flo = _mm_add_ps(_mm_cvtepi32_ps(lo), _mm_loadu_ps(acc + i));
+        __m128 fhi = _mm_add_ps(_mm_cvtepi32_ps(hi), _mm_loadu_ps(acc + i + 4));
+        flo = _mm_min_ps(_mm_max_ps(flo, lowest), highest);
+        fhi = _mm_min_ps(_mm_max_ps(fhi, lowest), highest);
+        _mm_storeu_si128((__m128i *)(stream + i), _mm_packs_epi32(_mm_cvtps_epi32(flo), _mm_cvtps_epi32(fhi)));
+    }
+    resolveScalar(stream + i, acc + i, samples - i);
+}
+#endif
+
+#ifdef MIXER_HAS_AVX2
+// 8 frames por vuelta (16 Sint16 -> dos vectores de 8 floats).
+MIXER_TARGET_AVX2
+static void accumulateAVX2(float *acc, const Sint16 *src, int frames, float gl, float gr)
+{
+    const __m256 gain = _mm256_setr_ps(gl, gr, gl, gr, gl, gr, gl, gr);
+    int i = 0;
+    for (; i + 8 <= frames; i += 8)
+    {
+        __m128i s0 = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+        __m128i s1 = _mm_loadu_si128((const __m128i *)(src + 2 * i + 8));
+        float *a = acc + 2 * i;
+        __m256 f0 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s0));
+        __m256 f1 = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s1));
+        _mm256_storeu_ps(a,     _mm256_add_ps(_mm256_loadu_ps(a),     _mm256_mul_ps(f0, gain)));
+        _mm256_storeu_ps(a + 8, _mm256_add_ps(_mm256_loadu_ps(a + 8), _mm256_mul_ps(f1, gain)));
+    }
+    _mm256_zeroupper(); // El resto (y el codigo de afuera) es SSE sin VEX
+    accumulateScalar(acc + 2 * i, src + 2 * i, frames - i, gl, gr);
+}
+
+// Igual que resolveSSE2 (saturacion en float), 16 muestras por vuelta.
+MIXER_TARGET_AVX2
+static void resolveAVX2(Sint16 *stream, const float *acc, int samples)
+{
+    const __m256 lowest  = _mm256_set1_ps(-32768.0f);
+    const __m256 highest = _mm256_set1_ps(32767.0f);
+    int i = 0;
+    for (; i + 16 <= samples; i += 16)
+    {
+        __m128i s0 = _mm_loadu_si128((const __m128i *)(stream + i));
+        __m128i s1 = _mm_loadu_si128((const __m128i *)(stream + i + 8));
+        __m256 f0 = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s0)), _mm256_loadu_ps(acc + i));
+        __m256 f1 = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(s1)), _mm256_loadu_ps(acc + i + 8));
+        f0 = _mm256_min_ps(_mm256_max_ps(f0, lowest), highest);
+        f1 = _mm256_min_ps(_mm256_max_ps(f1, lowest), highest);
+        __m256i i0 = _mm256_cvtps_epi32(f0);
+        __m256i i1 = _mm256_cvtps_epi32(f1);
+        // packs de 256 bits intercala los carriles: se empaqueta cada mitad por separado
+        _mm_storeu_si128((__m128i *)(stream + i),
+                         _mm_packs_epi32(_mm256_castsi256_si128(i0), _mm256_extracti128_si256(i0, 1)));
+        _mm_storeu_si128((__m128i *)(stream + i + 8),
+                         _mm_packs_epi32(_mm256_castsi256_si128(i1), _mm256_extracti128_si256(i1, 1)));
+    }
+    _mm256_zeroupper();
+    resolveScalar(stream + i, acc + i, samples - i);
+}
+#endif
+
+static const MixerOps kernels[MIXER_KERNEL_COUNT] = {
+    [MIXER_KERNEL_SCALAR] = {accumulateScalar, resolveScalar},
+#ifdef MIXER_HAS_SSE2
+    [MIXER_KERNEL_SSE2]   = {accumulateSSE2, resolveSSE2},
+#endif
+#ifdef MIXER_HAS_AVX2
+    [MIXER_KERNEL_AVX2]   = {accumulateAVX2, resolveAVX2},
+#endif
+};
+
+static bool kernelSupported(MixerKernel k)
+{
+    switch (k)
+    {
+        case MIXER_KERNEL_SCALAR: return true;
+        case MIXER_KERNEL_SSE2:   return kernels[k].accumulate && SDL_HasSSE2();
+        case MIXER_KERNEL_AVX2:   return kernels[k].accumulate && SDL_HasAVX2();
+        default:                  return false;
+    }
+}
+
+// ============================================================
+// Voces y comandos (static, hilo de audio)
+// ============================================================
+
+// Ley de balance: el centro deja los dos canales a ganancia completa.
+static void updateVoiceGain(MixerVoice *v)
+{
+    v->gain_l = v->gain * (v->pan > 0.0f ? 1.0f - v->pan : 1.0f);
+    v->gain_r = v->gain * (v->pan < 0.0f ? 1.0f + v->pan : 1.0f);
+}
+
+static MixerVoice *findVoice(int id)
+{
+    for (int i = 0; i < active; i++)
+    {
+        if (voices[i].id == id)
+            return &voices[i];
+    }
+    return NULL;
+}
+
+// La voz que empezo primero (edad en aritmetica sin signo: tolera la vuelta del contador).
+static MixerVoice *oldestVoice(void)
+{
+    MixerVoice *oldest = &voices[0];
+    for (int i = 1; i < active; i++)
+    {
+        if (playSerial - voices[i].serial > playSerial - oldest->serial)
+            oldest = &voices[i];
+    }
+    return oldest;
+}
+
+static void applyCommand(const MixerCommand *cmd)
+{
+    MixerVoice *v;
+    switch (cmd->type)
+    {
+        case MIXER_CMD_PLAY:
+            // Sin voz libre se corta la mas vieja: el id que devolvio
+            // Mixer_Play siempre corresponde a un sonido que empezo
+            if (active >= voiceCount)
+            {
+                v = oldestVoice();
+                SDL_AtomicAdd(&stolenVoices, 1);
+            }
+            else
+                v = &voices[active++];
+            *v = (MixerVoice){cmd->id, cmd->samples, cmd->frames, 0, ++playSerial, cmd->gain, cmd->pan, 0.0f, 0.0f};
+            updateVoiceGain(v);
+            break;
+        case MIXER_CMD_STOP:
+            if ((v = findVoice(cmd->id)))
+                *v = voices[--active];
+            break;
+        case MIXER_CMD_GAIN:
+            if ((v = findVoice(cmd->id)))
+            {
+                v->gain = cmd->gain;
+                updateVoiceGain(v);
+            }
+            break;
+    }
+}
+
+static void applyCommands(void)
+{
+    unsigned head = (unsigned)SDL_AtomicGet(&ringHead);
+    unsigned tail = (unsigned)SDL_AtomicGet(&ringTail);
+    SDL_MemoryBarrierAcquire();
+    if (head == tail)
+        return;
+
+    for (; head != tail; head++)
+        applyCommand(&ring[head & (MIXER_RING_SIZE - 1)]);
+
+    // El productor puede reusar las entradas recien despues de esto
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ringHead, (int)head);
+}
+
+// ============================================================
+// Cola de comandos (static, hilo del juego)
+// ============================================================
+
+static bool pushCommand(const MixerCommand *cmd)
+{
+    unsigned tail = (unsigned)SDL_AtomicGet(&ringTail);
+    unsigned head = (unsigned)SDL_AtomicGet(&ringHead);
+    if (tail - head >= MIXER_RING_SIZE)
+    {
+        droppedCommands++;
+        return false;
+    }
+
+    ring[tail & (MIXER_RING_SIZE - 1)] = *cmd;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ringTail, (int)(tail + 1));
+    return true;
+}
+
+// Callback de SDL_mixer, despues de mezclar la musica y sus canales.
+static void postMix(void *udata, Uint8 *stream, int len)
+{
+    (void)udata;
+    Mixer_Render((Sint16 *)stream, len / MIXER_FRAME_BYTES);
+}
+
+// ============================================================
+// API
+// ============================================================
+
+bool Mixer_Init(int count)
+{
+    Mixer_Quit();
+    if (count <= 0)
+        return false;
+
+    voices = calloc((size_t)count, sizeof(MixerVoice));
+    if (!voices)
+    {
+        printDebug(LOG_ERROR, "No se pudieron reservar %d voces para el mezclador\n", count);
+        return false;
+    }
+    voiceCount = count;
+    active = 0;
+    nextId = 1;
+    droppedCommands = 0;
+    SDL_AtomicSet(&ringHead, 0);
+    SDL_AtomicSet(&ringTail, 0);
+    SDL_AtomicSet(&activeShared, 0);
+    SDL_AtomicSet(&stolenVoices, 0);
+    playSerial = 0;
+
+    kernel = MIXER_KERNEL_SCALAR;
+    for (int k = MIXER_KERNEL_COUNT - 1; k > MIXER_KERNEL_SCALAR; k--)
+    {
+        if (kernelSupported((MixerKernel)k))
+        {
+            kernel = (MixerKernel)k;
+            break;
+        }
+    }
+    return true;
+}
+
+bool Mixer_Attach(void)
+{
+    if (!voices)
+        return false;
+    if (attached)
+        return true;
+
+    int freq = 0, channels = 0;
+    Uint16 format = 0;
+    if (!Mix_QuerySpec(&freq, &format, &channels))
+    {
+        printDebug(LOG_WARN, "Mezclador: el dispositivo de audio no esta abierto\n");
+        return false;
+    }
+    if (format != AUDIO_S16SYS || channels != 2)
+    {
+        printDebug(LOG_WARN, "Mezclador: formato de audio no soportado (0x%x, %d canales), se usan los canales de SDL_mixer\n",
+                   format, channels);
+        return false;
+    }
+
+    Mix_SetPostMix(postMix, NULL);
+    attached = true;
+    printDebug(LOG_INFO, "Mezclador por software: %d voces a %d Hz (kernel %s)\n",
+               voiceCount, freq, Mixer_KernelName(kernel));
+    return true;
+}
+
+void Mixer_Quit(void)
+{
+    if (attached)
+        Mix_SetPostMix(NULL, NULL); // Espera a que termine el callback en curso
+    attached = false;
+    free(voices);
+    voices = NULL;
+    voiceCount = 0;
+    active = 0;
+}
+
+bool Mixer_IsActive(void)
+{
+    return attached;
+}
+
+int Mixer_Play(const Mix_Chunk *chunk, float gain, float pan)
+{
+    if (!voices || !chunk || !chunk->abuf)
+        return -1;
+
+    MixerCommand cmd = {
+        .type = MIXER_CMD_PLAY,
+        .id = nextId,
+        .samples = (const Sint16 *)chunk->abuf,
+        .frames = chunk->alen / MIXER_FRAME_BYTES,
+        .gain = gain * (float)chunk->volume / MIX_MAX_VOLUME,
+        .pan = SDL_max(-1.0f, SDL_min(pan, 1.0f)),
+    };
+    if (!pushCommand(&cmd))
+        return -1;
+
+    nextId = nextId == SDL_MAX_SINT32 ? 1 : nextId + 1;
+    return cmd.id;
+}
+
+bool Mixer_Stop(int voice)
+{
+    if (!voices || voice <= 0)
+        return false;
+    return pushCommand(&(MixerCommand){.type = MIXER_CMD_STOP, .id = voice});
+}
+
+bool Mixer_SetGain(int voice, float gain)
+{
+    if (!voices || voice <= 0)
+        return false;
+    return pushCommand(&(MixerCommand){.type = MIXER_CMD_GAIN, .id = voice, .gain = gain});
+}
+
+// Con el post-mix quitado el hilo de audio no toca nada: se vacian voces y cola.
+void Mixer_Halt(void)
+{
+    if (!voices)
+        return;
+    if (attached)
+        Mix_SetPostMix(NULL, NULL);
+
+    active = 0;
+    SDL_AtomicSet(&activeShared, 0);
+    SDL_AtomicSet(&ringHead, SDL_AtomicGet(&ringTail));
+
+    if (attached)
+        Mix_SetPostMix(postMix, NULL);
+}
+
+void Mixer_Render(Sint16 *stream, int frames)
+{
+    applyCommands();
+
+    const MixerOps *ops = &kernels[kernel];
+    for (int done = 0; done < frames && active > 0; done += MIXER_BLOCK)
+    {
+        int n = SDL_min(MIXER_BLOCK, frames - done);
+        memset(mixBlock, 0, (size_t)n * 2 * sizeof(float));
+
+        for (int i = 0; i < active;)
+        {
+            MixerVoice *v = &voices[i];
+            int len = (int)SDL_min((Uint32)n, v->frames - v->pos);
+            ops->accumulate(mixBlock, v->samples + (size_t)v->pos * 2, len, v->gain_l, v->gain_r);
+            v->pos += (Uint32)len;
+            if (v->pos >= v->frames)
+                *v = voices[--active]; // Termino: la ultima ocupa su lugar
+            else
+                i++;
+        }
+        ops->resolve(stream + (size_t)done * 2, mixBlock, n * 2);
+    }
+    SDL_AtomicSet(&activeShared, active);
+}
+
+bool Mixer_SetKernel(MixerKernel k)
+{
+    if (attached || !kernelSupported(k))
+        return false;
+    kernel = k;
+    return true;
+}
+
+const char *Mixer_KernelName(MixerKernel k)
+{
+    switch (k)
+    {
+        case MIXER_KERNEL_SCALAR: return "escalar";
+        case MIXER_KERNEL_SSE2:   return "sse2";
+        case MIXER_KERNEL_AVX2:   return "avx2";
+        default:                  return "?";
+    }
+}
+
+MixerStats Mixer_GetStats(void)
+{
+    return (MixerStats){
+        .voices = voiceCount,
+        .active = SDL_AtomicGet(&activeShared),
+        .stolen_voices = SDL_AtomicGet(&stolenVoices),
+        .dropped_commands = droppedCommands,
+        .kernel = kernel,
+    };
+}
@@ -0,0 +1,133 @@
+/**
+ * @file pacer.c
+ * @brief Implementacion del limitador de framerate por deadlines.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#define _POSIX_C_SOURCE 200809L
+#include <sched.h>
+
+#include "pacer.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+/** @brief Margen final (ms) que se espera cediendo la CPU en vez de dormir. */
+#define PACER_SPIN_MS 2
+
+static int    targetFps   = 0; // 0 = sin limite
+static Uint64 frequency   = 0; // Ticks del contador por segundo
+static Uint64 periodWhole = 0; // Parte entera del periodo (ticks)
+static Uint64 periodFrac  = 0; // Resto del periodo (en 1/targetFps de tick)
+static Uint64 fracAcc     = 0; // Resto acumulado entre frames
+static Uint64 deadline    = 0; // Deadline absoluto del frame actual
+static Uint64 spinTicks   = 0; // PACER_SPIN_MS convertido a ticks
+
+static PacerStats stats   = {0};
+static double errorSum    = 0.0;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Avanza el deadline un periodo, acumulando la fraccion de tick.
+static void advanceDeadline(void)
+{
+    deadline += periodWhole;
+    fracAcc  += periodFrac;
+    if (fracAcc >= (Uint64)targetFps)
+    {
+        fracAcc -= (Uint64)targetFps;
+        deadline++;
+    }
+}
+
+// Registra el error (en ticks con signo) del frame que acaba de terminar.
+static void recordError(Sint64 errorTicks)
+{
+    double us = (double)errorTicks * 1000000.0 / (double)frequency;
+    double absUs = us < 0 ? -us : us;
+
+    stats.last_error_us = us;
+    if (absUs > stats.max_error_us)
+        stats.max_error_us = absUs;
+    stats.frames++;
+    errorSum += absUs;
+    stats.mean_abs_error_us = errorSum / (double)stats.frames;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+// Calcula el periodo exacto en ticks del contador y arma el primer deadline.
+void Pacer_Init(int fps)
+{
+    targetFps = fps > 0 ? fps : 0;
+    frequency = SDL_GetPerformanceFrequency();
+    spinTicks = frequency * PACER_SPIN_MS / 1000;
+    fracAcc   = 0;
+
+    if (targetFps > 0)
+    {
+        periodWhole = frequency / (Uint64)targetFps;
+        periodFrac  = frequency % (Uint64)targetFps;
+    }
+
+    deadline = SDL_GetPerformanceCounter();
+    advanceDeadline();
+    Pacer_ResetStats();
+}
+
+// Duerme en grueso, cede la CPU en el tramo final y agenda el siguiente deadline.
+void Pacer_Wait(void)
+{
+    if (targetFps <= 0)
+        return;
+
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Tramo grueso: SDL_Delay hasta quedar a PACER_SPIN_MS del deadline
+    if (now + spinTicks < deadline)
+    {
+        Uint32 sleepMs = (Uint32)((deadline - now - spinTicks) * 1000 / frequency);
+        if (sleepMs > 0)
+            SDL_Delay(sleepMs);
+        now = SDL_GetPerformanceCounter();
+    }
+
+    // Tramo fino: ceder la CPU hasta alcanzar el deadline exacto
+    while (now < deadline)
+    {
+        sched_yield();
+        now = SDL_GetPerformanceCounter();
+    }
+
+    recordError((Sint64)(now - deadline));
+    advanceDeadline();
+
+    // Mas de un periodo tarde: no intentar recuperar con frames en rafaga
+    if (deadline <= now)
+    {
+        stats.resyncs++;
+        deadline = now;
+        fracAcc  = 0;
+        advanceDeadline();
+    }
+}
+
+// Devuelve una copia de las estadisticas.
+PacerStats Pacer_GetStats(void)
+{
+    return stats;
+}
+
+// Reinicia las estadisticas de precision.
+void Pacer_ResetStats(void)
+{
+    stats = (PacerStats){0};
+    errorSum = 0.0;
+}
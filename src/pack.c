@@ -0,0 +1,499 @@
+/**
+ * @file pack.c
+ * @brief Implementacion del paquete de assets: mapeo, busqueda y generador.
+ *
+ * Con PACK_MAIN definido, este archivo aporta su propio main() que genera
+ * el paquete a partir de los archivos sueltos de assets/:
+ * @code
+ * make pack                       # genera PACK_FILE
+ * make pack ARGS="otro.pak"       # ruta de salida alternativa
+ * @endcode
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pack.h"
+#include "tools.h"
+
+_Static_assert(sizeof(PackHeader) == 48, "PackHeader debe medir 48 bytes");
+_Static_assert(sizeof(PackEntry) == 48, "PackEntry debe medir 48 bytes");
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+static const Uint8     *base    = NULL; // Inicio del archivo mapeado
+static size_t           mapSize = 0;
+static const PackHeader *header = NULL;
+static const PackEntry  *toc    = NULL;
+static const char       *names  = NULL;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Comprueba que la tabla y todos los blobs caigan dentro del archivo.
+static bool validate(void)
+{
+    if (mapSize < sizeof(PackHeader))
+        return false;
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION)
+        return false;
+
+    Uint64 size = mapSize;
+    if (header->toc_offset % 8 != 0 || header->toc_offset > size)
+        return false;
+    if (header->entry_count > (size - header->toc_offset) / sizeof(PackEntry))
+        return false;
+    if (header->names_size == 0 || header->names_offset > size || header->names_size > size - header->names_offset)
+        return false;
+    if (base[header->names_offset + header->names_size - 1] != '\0')
+        return false;
+
+    const PackEntry *entries = (const PackEntry *)(base + header->toc_offset);
+    for (Uint32 i = 0; i < header->entry_count; i++)
+    {
+        const PackEntry *e = &entries[i];
+        if (e->offset > size || e->size > size - e->offset || e->name >= header->names_size)
+            return false;
+        if (i > 0 && entries[i - 1].hash > e->hash)
+            return false;
+        if (e->type == PACK_IMAGE && ((Uint64)e->pitch * e->height > e->size || (Uint64)e->width * 4 > e->pitch))
+            return false;
+    }
+    return true;
+}
+
+static int compareNames(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+// ============================================================
+// Apertura y cierre
+// ============================================================
+
+// Mapea el archivo completo (solo lectura) y pide al kernel que lo vaya leyendo.
+bool Pack_Open(const char *path)
+{
+    Pack_Close();
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        printDebug(LOG_INFO, "Sin paquete de assets '%s': se usan archivos sueltos\n", path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        printDebug(LOG_WARN, "Paquete de assets '%s' vacio o ilegible\n", path);
+        return false;
+    }
+
+    void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        printDebug(LOG_ERROR, "No se pudo mapear '%s'\n", path);
+        return false;
+    }
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_WILLNEED);
+
+    base    = map;
+    mapSize = (size_t)st.st_size;
+    header  = map;
+    if (!validate())
+    {
+        printDebug(LOG_ERROR, "Paquete de assets '%s' invalido o de otra version\n", path);
+        Pack_Close();
+        return false;
+    }
+    toc   = (const PackEntry *)(base + header->toc_offset);
+    names = (const char *)(base + header->names_offset);
+
+    printDebug(LOG_INFO, "Paquete de assets '%s': %u entradas, %zu KB\n", path, header->entry_count, mapSize / 1024);
+    return true;
+}
+
+// Desmapea el archivo.
+void Pack_Close(void)
+{
+    if (base)
+        munmap((void *)base, mapSize);
+    base    = NULL;
+    mapSize = 0;
+    header  = NULL;
+    toc     = NULL;
+    names   = NULL;
+}
+
+bool Pack_IsOpen(void)
+{
+    return base != NULL;
+}
+
+// ============================================================
+// Consulta
+// ============================================================
+
+// Busqueda binaria por hash; el nombre confirma (rutas que no estan pueden colisionar).
+const PackEntry *Pack_Find(const char *path)
+{
+    if (!toc || !path)
+        return NULL;
+
+    Uint64 hash = hashString(path);
+    Uint32 lo = 0, hi = header->entry_count;
+    while (lo < hi)
+    {
+        Uint32 mid = lo + (hi - lo) / 2;
+        if (toc[mid].hash < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < header->entry_count && toc[lo].hash == hash && !strcmp(names + toc[lo].name, path))
+        return &toc[lo];
+    return NULL;
+}
+
+const void *Pack_Data(const PackEntry *e)
+{
+    return e ? base + e->offset : NULL;
+}
+
+// Nombres (sin directorio) de las entradas de 'type' que estan directamente en 'dir'.
+char **Pack_ListDir(const char *dir, PackType type, int *outCount)
+{
+    *outCount = 0;
+    if (!toc || !dir)
+        return NULL;
+
+    size_t dirLen = strlen(dir);
+    int count = 0;
+    for (Uint32 i = 0; i < header->entry_count; i++)
+    {
+        const char *name = names + toc[i].name;
+        if (toc[i].type == (Uint32)type && !strncmp(name, dir, dirLen) && !strchr(name + dirLen, '/'))
+            count++;
+    }
+    if (count == 0)
+        return NULL;
+
+    char **list = calloc((size_t)count, sizeof(char *));
+    if (!list)
+        return NULL;
+    int n = 0;
+    for (Uint32 i = 0; i < header->entry_count && n < count; i++)
+    {
+        const char *name = names + toc[i].name;
+        if (toc[i].type != (Uint32)type || strncmp(name, dir, dirLen) || strchr(name + dirLen, '/'))
+            continue;
+        list[n] = strdup(name + dirLen);
+        if (!list[n])
+        {
+            freeStringArray(list, n);
+            return NULL;
+        }
+        n++;
+    }
+
+    // Orden estable entre corridas (la tabla esta ordenada por hash)
+    qsort(list, (size_t)n, sizeof(char *), compareNames);
+    *outCount = n;
+    return list;
+}
+
+// ============================================================
+// Creacion de recursos
+// ============================================================
+
+// La superficie no es duenha de los pixeles: SDL_FreeSurface no los libera.
+SDL_Surface *Pack_CreateSurface(const PackEntry *e)
+{
+    if (!e || e->type != PACK_IMAGE)
+        return NULL;
+    return SDL_CreateRGBSurfaceWithFormatFrom((void *)Pack_Data(e), (int)e->width, (int)e->height,
+                                              32, (int)e->pitch, header->pixel_format);
+}
+
+// Sin logs: Pack_CreateChunk corre en los workers de initSfxLib.
+bool Pack_AudioMatches(void)
+{
+    int freq = 0, channels = 0;
+    Uint16 format = 0;
+    if (!header || !Mix_QuerySpec(&freq, &format, &channels))
+        return false;
+    return freq == header->audio_freq && format == header->audio_format && channels == header->audio_channels;
+}
+
+// Mix_QuickLoad_RAW no copia ni convierte: el formato del mixer tiene que coincidir.
+Mix_Chunk *Pack_CreateChunk(const PackEntry *e)
+{
+    if (!e || e->type != PACK_SOUND || !Pack_AudioMatches())
+        return NULL;
+    return Mix_QuickLoad_RAW((Uint8 *)Pack_Data(e), (Uint32)e->size);
+}
+
+// ============================================================
+// Generador del paquete
+// ============================================================
+
+#ifdef PACK_MAIN
+
+#include <SDL_image.h>
+
+#include "atlas.h"
+#include "img.h"
+#include "jsonHandler.h"
+#include "sound.h"
+
+typedef struct {
+    PackEntry entry;
+    char     *name;
+} PackItem;
+
+typedef struct {
+    FILE     *file;
+    PackItem *items;
+    int       count;
+    int       capacity;
+    Uint64    pos; // Bytes escritos hasta ahora
+} PackWriter;
+
+static const char *imageExts[] = {".png", ".jpg", ".jpeg", ".bmp"};
+static const char *soundExts[] = {".wav", ".ogg", ".mp3"};
+static const char *dataExts[]  = {".json"};
+
+// Rellena con ceros hasta el siguiente multiplo de 'align'.
+static bool writePadding(PackWriter *w, Uint64 align)
+{
+    static const char zeros[PACK_ALIGN] = {0};
+    Uint64 pad = (align - w->pos % align) % align;
+    if (pad && fwrite(zeros, 1, (size_t)pad, w->file) != pad)
+        return false;
+    w->pos += pad;
+    return true;
+}
+
+// Escribe un blob alineado y registra su entrada.
+static bool writerAdd(PackWriter *w, const char *path, PackType type, const void *data, Uint64 size,
+                      Uint32 width, Uint32 height, Uint32 pitch)
+{
+    if (w->count == w->capacity)
+    {
+        int capacity = w->capacity ? w->capacity * 2 : 64;
+        PackItem *grown = realloc(w->items, (size_t)capacity * sizeof(PackItem));
+        if (!grown)
+            return false;
+        w->items = grown;
+        w->capacity = capacity;
+    }
+    if (!writePadding(w, PACK_ALIGN))
+        return false;
+    if (size && fwrite(data, 1, (size_t)size, w->file) != size)
+        return false;
+
+    char *name = strdup(path);
+    if (!name)
+        return false;
+    w->items[w->count++] = (PackItem){
+        .entry = {.hash = hashString(path), .offset = w->pos, .size = size, .type = (Uint32)type,
+                  .width = width, .height = height, .pitch = pitch},
+        .name  = name
+    };
+    w->pos += size;
+    printf("  %-56s %10llu bytes\n", path, (unsigned long long)size);
+    return true;
+}
+
+// Imagenes decodificadas y convertidas al formato de las paginas del atlas.
+static int packImages(PackWriter *w, const char *dir)
+{
+    int n = 0, added = 0;
+    char **files = getFilesFromDir((char *)dir, &n, imageExts, ARRAY_L(imageExts), IMAGE);
+    Uint32 format = Atlas_PixelFormat();
+    for (int i = 0; files && i < n; i++)
+    {
+        char path[strlen(dir) + strlen(files[i]) + 1];
+        snprintf(path, sizeof(path), "%s%s", dir, files[i]);
+        SDL_Surface *srf = IMG_Load(path);
+        SDL_Surface *conv = srf ? SDL_ConvertSurfaceFormat(srf, format, 0) : NULL;
+        SDL_FreeSurface(srf);
+        if (!conv)
+        {
+            printDebug(LOG_WARN, "No se pudo decodificar '%s': %s\n", path, SDL_GetError());
+            continue;
+        }
+        SDL_LockSurface(conv);
+        if (writerAdd(w, path, PACK_IMAGE, conv->pixels, (Uint64)conv->pitch * (Uint64)conv->h,
+                      (Uint32)conv->w, (Uint32)conv->h, (Uint32)conv->pitch))
+            added++;
+        SDL_UnlockSurface(conv);
+        SDL_FreeSurface(conv);
+    }
+    freeStringArray(files, n);
+    return added;
+}
+
+// Sonidos decodificados por el propio mixer: el PCM queda en su formato exacto.
+static int packSounds(PackWriter *w, const char *dir)
+{
+    int n = 0, added = 0;
+    char **files = getFilesFromDir((char *)dir, &n, soundExts, ARRAY_L(soundExts), SOUND);
+    for (int i = 0; files && i < n; i++)
+    {
+        char path[strlen(dir) + strlen(files[i]) + 1];
+        snprintf(path, sizeof(path), "%s%s", dir, files[i]);
+        Mix_Chunk *chunk = Mix_LoadWAV(path);
+        if (!chunk)
+        {
+            printDebug(LOG_WARN, "No se pudo decodificar '%s': %s\n", path, Mix_GetError());
+            continue;
+        }
+        if (writerAdd(w, path, PACK_SOUND, chunk->abuf, chunk->alen, 0, 0, 0))
+            added++;
+        Mix_FreeChunk(chunk);
+    }
+    freeStringArray(files, n);
+    return added;
+}
+
+// Archivos de datos copiados tal cual.
+static int packData(PackWriter *w, const char *dir)
+{
+    int n = 0, added = 0;
+    char **files = getFilesFromDir((char *)dir, &n, dataExts, ARRAY_L(dataExts), LOG);
+    for (int i = 0; files && i < n; i++)
+    {
+        char path[strlen(dir) + strlen(files[i]) + 1];
+        snprintf(path, sizeof(path), "%s%s", dir, files[i]);
+        FILE *f = fopen(path, "rb");
+        long size = fileSize(f);
+        char *buffer = size > 0 ? malloc((size_t)size) : NULL;
+        if (buffer && fread(buffer, 1, (size_t)size, f) == (size_t)size
+            && writerAdd(w, path, PACK_DATA, buffer, (Uint64)size, 0, 0, 0))
+            added++;
+        else
+            printDebug(LOG_WARN, "No se pudo leer '%s'\n", path);
+        free(buffer);
+        if (f)
+            fclose(f);
+    }
+    freeStringArray(files, n);
+    return added;
+}
+
+static int compareItems(const void *a, const void *b)
+{
+    Uint64 x = ((const PackItem *)a)->entry.hash;
+    Uint64 y = ((const PackItem *)b)->entry.hash;
+    return (x > y) - (x < y);
+}
+
+// Tabla de nombres + tabla de contenidos (ordenada por hash) + cabecera final.
+static bool writeTables(PackWriter *w, PackHeader *hdr)
+{
+    qsort(w->items, (size_t)w->count, sizeof(PackItem), compareItems);
+    for (int i = 1; i < w->count; i++)
+    {
+        if (w->items[i].entry.hash == w->items[i - 1].entry.hash)
+        {
+            printDebug(LOG_ERROR, "Colision de hash entre '%s' y '%s'\n", w->items[i - 1].name, w->items[i].name);
+            return false;
+        }
+    }
+
+    hdr->names_offset = w->pos;
+    for (int i = 0; i < w->count; i++)
+    {
+        size_t len = strlen(w->items[i].name) + 1;
+        w->items[i].entry.name = (Uint32)(w->pos - hdr->names_offset);
+        if (fwrite(w->items[i].name, 1, len, w->file) != len)
+            return false;
+        w->pos += len;
+    }
+    hdr->names_size = w->pos - hdr->names_offset;
+
+    if (!writePadding(w, 8))
+        return false;
+    hdr->toc_offset  = w->pos;
+    hdr->entry_count = (Uint32)w->count;
+    for (int i = 0; i < w->count; i++)
+    {
+        if (fwrite(&w->items[i].entry, sizeof(PackEntry), 1, w->file) != 1)
+            return false;
+        w->pos += sizeof(PackEntry);
+    }
+
+    return fseek(w->file, 0, SEEK_SET) == 0 && fwrite(hdr, sizeof(PackHeader), 1, w->file) == 1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *out = argc > 1 ? argv[1] : PACK_FILE;
+    config.debug_mode = true;
+
+    // El mixer se abre con los mismos parametros que en el juego (driver dummy)
+    SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy");
+    if (SDL_Init(0) != 0 || !initTexture() || !initAudio())
+    {
+        fprintf(stderr, "No se pudo iniciar SDL: %s\n", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+
+    PackHeader hdr = {.magic = PACK_MAGIC, .version = PACK_VERSION, .pixel_format = Atlas_PixelFormat()};
+    int freq = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&freq, &format, &channels);
+    hdr.audio_freq     = freq;
+    hdr.audio_format   = format;
+    hdr.audio_channels = (Uint16)channels;
+
+    PackWriter w = {.file = fopen(out, "wb")};
+    if (!w.file)
+    {
+        fprintf(stderr, "No se pudo crear '%s'\n", out);
+        return EXIT_FAILURE;
+    }
+
+    // Lugar para la cabecera; se reescribe al final con los offsets
+    bool ok = fwrite(&hdr, sizeof(PackHeader), 1, w.file) == 1;
+    w.pos = sizeof(PackHeader);
+
+    printf("Generando '%s'\n", out);
+    int images = ok ? packImages(&w, SPRITES_DIR) : 0;
+    int sounds = ok ? packSounds(&w, SFX_DIR) : 0;
+    int data   = ok ? packData(&w, JSON_SPRITE_DIR) : 0;
+    ok = ok && writeTables(&w, &hdr);
+    ok = (fclose(w.file) == 0) && ok;
+
+    for (int i = 0; i < w.count; i++)
+        free(w.items[i].name);
+    free(w.items);
+    quitAudio();
+    quitTexture();
+    SDL_Quit();
+
+    if (!ok)
+    {
+        fprintf(stderr, "Error escribiendo '%s'\n", out);
+        remove(out);
+        return EXIT_FAILURE;
+    }
+    printf("%d imagenes, %d sonidos, %d datos, %llu KB (%d Hz, %d canales)\n", images, sounds, data,
+           (unsigned long long)(w.pos / 1024), freq, channels);
+    return 0;
+}
+
+#endif
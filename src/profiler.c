@@ -0,0 +1,145 @@
+/**
+ * @file profiler.c
+ * @brief Implementacion de la medicion de tiempos por fase.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+static const char *phaseNames[PROF_PHASE_COUNT] = {"input", "update", "render", "frame"};
+
+static double *samples[PROF_PHASE_COUNT] = {0}; // Duraciones en ms
+static int     counts[PROF_PHASE_COUNT]  = {0};
+static Uint64  starts[PROF_PHASE_COUNT]  = {0};
+static int     capacity  = 0;
+static double  msPerTick = 0.0;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+static int compareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil por rango mas cercano sobre un array ordenado.
+static double percentile(const double *sorted, int n, double p)
+{
+    int rank = (int)ceil(p / 100.0 * n);
+    if (rank < 1)
+        rank = 1;
+    if (rank > n)
+        rank = n;
+    return sorted[rank - 1];
+}
+
+// ============================================================
+// API
+// ============================================================
+
+// Reserva todos los buffers de una vez para no hacer allocs en el loop.
+bool Prof_Init(int maxFrames)
+{
+    Prof_Quit();
+    if (maxFrames <= 0)
+        return false;
+
+    for (int p = 0; p < PROF_PHASE_COUNT; p++)
+    {
+        samples[p] = malloc((size_t)maxFrames * sizeof(double));
+        if (!samples[p])
+        {
+            printDebug(LOG_ERROR, "No se pudo reservar memoria para el profiler (%d frames)\n", maxFrames);
+            Prof_Quit();
+            return false;
+        }
+    }
+    capacity  = maxFrames;
+    msPerTick = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return true;
+}
+
+// Libera los buffers y deja el profiler inactivo.
+void Prof_Quit(void)
+{
+    for (int p = 0; p < PROF_PHASE_COUNT; p++)
+    {
+        free(samples[p]);
+        samples[p] = NULL;
+        counts[p]  = 0;
+    }
+    capacity = 0;
+}
+
+void Prof_Begin(ProfPhase phase)
+{
+    if (capacity > 0)
+        starts[phase] = SDL_GetPerformanceCounter();
+}
+
+void Prof_End(ProfPhase phase)
+{
+    if (capacity <= 0 || counts[phase] >= capacity)
+        return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    samples[phase][counts[phase]++] = (double)(now - starts[phase]) * msPerTick;
+}
+
+// Ordena una copia de las muestras para sacar los percentiles.
+ProfStats Prof_GetStats(ProfPhase phase)
+{
+    ProfStats st = {0};
+    int n = counts[phase];
+    if (n <= 0)
+        return st;
+
+    double *sorted = malloc((size_t)n * sizeof(double));
+    if (!sorted)
+        return st;
+    memcpy(sorted, samples[phase], (size_t)n * sizeof(double));
+    qsort(sorted, (size_t)n, sizeof(double), compareDouble);
+
+    double sum = 0.0;
+    for (int i = 0; i < n; i++)
+        sum += sorted[i];
+
+    st.samples = n;
+    st.mean    = sum / n;
+    st.p50     = percentile(sorted, n, 50.0);
+    st.p95     = percentile(sorted, n, 95.0);
+    st.p99     = percentile(sorted, n, 99.0);
+    st.max     = sorted[n - 1];
+    free(sorted);
+    return st;
+}
+
+// {"frames": N, "phases": {"input": {"mean_ms": ..., ...}, ...}}
+void Prof_PrintJSON(FILE *out)
+{
+    fprintf(out, "{\n  \"frames\": %d,\n  \"phases\": {\n", counts[PROF_FRAME]);
+    for (int p = 0; p < PROF_PHASE_COUNT; p++)
+    {
+        ProfStats st = Prof_GetStats((ProfPhase)p);
+        fprintf(out,
+                "    \"%s\": {\"samples\": %d, \"mean_ms\": %.4f, \"p50_ms\": %.4f, "
+                "\"p95_ms\": %.4f, \"p99_ms\": %.4f, \"max_ms\": %.4f}%s\n",
+                phaseNames[p], st.samples, st.mean, st.p50, st.p95, st.p99, st.max,
+                p + 1 < PROF_PHASE_COUNT ? "," : "");
+    }
+    fprintf(out, "  }\n}\n");
+    fflush(out);
+}
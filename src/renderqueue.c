@@ -0,0 +1,712 @@
+/**
+ * @file renderqueue.c
+ * @brief Implementacion de la cola de render: claves de 64 bits, radix sort
+ *        y despacho agrupado por textura + blend mode.
+ *
+ * Los vertices de cada comando se guardan en orden de envio. Al despachar
+ * se copian en orden de clave a un buffer contiguo, asi que cada tramo de
+ * comandos con la misma textura y blend mode es una sola llamada.
+ *
+ * En modo dirty rects cada comando tiene ademas una firma (hash de
+ * textura, generacion de su contenido, clave y vertices) y su caja en
+ * pantalla. Las firmas del frame
+ * se ordenan y se cruzan con las del frame anterior: lo que aparece en
+ * uno solo de los dos frames es una region sucia.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "renderqueue.h"
+#include "batch.h"
+#include "camera.h"
+#include "config.h"
+#include "engine.h"
+#include "tools.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define RQ_MIN_ITEMS     256
+#define RQ_TEXTURE_SLOTS 1024   // Tabla textura -> id (potencia de 2)
+#define RQ_MAX_TEXTURES  (RQ_TEXTURE_SLOTS / 2)
+#define RQ_NO_ID         0xFFFF // Textura sin id (tabla llena): se agrupa aparte
+
+#define RQ_GENERATIONS   256    // Texturas con contenido redibujado (potencia de 2)
+#define RQ_MAX_DIRTY     16     // Regiones sucias por frame (se fusionan al llenarse)
+#define RQ_FULL_REDRAW   50     // % de pantalla sucia a partir del cual se redibuja todo
+
+#define RQ_LAYER_SHIFT   56
+#define RQ_TEXTURE_SHIFT 40
+#define RQ_BLEND_SHIFT   36
+
+// Datos de una textura durante el frame: id para la clave y escala de UVs.
+typedef struct {
+    SDL_Texture  *texture;
+    Uint32        frame;   // Frame en que se registro (las entradas viejas estan libres)
+    Uint16        id;
+    SDL_BlendMode blend;
+    Uint32        generation; // Version del contenido (RenderQueue_TextureChanged)
+    float         inv_w;
+    float         inv_h;
+} TextureSlot;
+
+// Version del contenido de una textura que se redibujo (modo dirty rects).
+typedef struct {
+    SDL_Texture *texture;
+    Uint32       generation;
+} TextureGeneration;
+
+typedef struct {
+    SDL_Texture  *texture;
+    SDL_BlendMode blend;
+    int           first_quad; // En el buffer de vertices en orden de envio
+    int           quad_count;
+    Uint64        key;        // Copia de la clave (items se reordena al ordenar)
+    Uint32        generation; // Version del contenido de la textura
+} RenderCommand;
+
+typedef struct {
+    Uint64 key;
+    int    command;
+} SortItem;
+
+// Comando del frame anterior (modo dirty rects), ordenado por firma.
+typedef struct {
+    Uint64   signature;
+    SDL_Rect bounds;
+} DrawnCommand;
+
+static TextureSlot textureSlots[RQ_TEXTURE_SLOTS];
+static Uint32 frameStamp   = 0;
+static int textureCount    = 0;
+
+static RenderCommand *commands = NULL;
+static SortItem *items         = NULL;
+static SortItem *itemsTmp      = NULL;
+static int commandCount        = 0;
+static int commandCapacity     = 0;
+
+static SDL_Vertex *vertices    = NULL; // Orden de envio
+static SDL_Vertex *merged      = NULL; // Orden de clave (despacho)
+static int quadCount           = 0;
+static int quadCapacity        = 0;
+
+static SDL_Rect *bounds        = NULL; // Caja en pantalla de cada comando (modo dirty rects)
+static SortItem *sigItems      = NULL; // Firmas del frame (key = firma)
+static SortItem *sigTmp        = NULL;
+
+// -- Modo dirty rects --
+static bool dirtyMode          = false;
+static bool cacheValid         = false;
+static SDL_Texture *cache      = NULL; // Frame del mundo retenido entre frames
+static int cacheW = 0, cacheH  = 0;
+static DrawnCommand *drawn     = NULL; // Comandos del frame anterior
+static int drawnCount          = 0;
+static int drawnCapacity       = 0;
+static SDL_Rect dirty[RQ_MAX_DIRTY];
+static int dirtyCount          = 0;
+static TextureGeneration generations[RQ_GENERATIONS]; // Direccionamiento abierto por puntero
+static int generationCount     = 0;
+
+static bool queueOpen          = false;
+static SDL_Texture *lastSubmitted = NULL;
+static RenderQueueStats stats   = {0};
+static RenderQueueStats pending = {0};
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Redimensiona un buffer a 'count' elementos (el original queda intacto si falla).
+static bool resizeBuffer(void **buffer, int count, size_t elemSize)
+{
+    void *tmp = realloc(*buffer, (size_t)count * elemSize);
+    if (!tmp)
+        return false;
+    *buffer = tmp;
+    return true;
+}
+
+// Asegura lugar para un comando mas y 'quads' quads mas.
+static bool reserve(int quads)
+{
+    if (commandCount >= commandCapacity)
+    {
+        int cap = commandCapacity > 0 ? commandCapacity * 2 : RQ_MIN_ITEMS;
+        if (!resizeBuffer((void **)&commands, cap, sizeof(RenderCommand)) ||
+            !resizeBuffer((void **)&items, cap, sizeof(SortItem)) ||
+            !resizeBuffer((void **)&itemsTmp, cap, sizeof(SortItem)) ||
+            !resizeBuffer((void **)&bounds, cap, sizeof(SDL_Rect)) ||
+            !resizeBuffer((void **)&sigItems, cap, sizeof(SortItem)) ||
+            !resizeBuffer((void **)&sigTmp, cap, sizeof(SortItem)))
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para la cola de render\n");
+            return false;
+        }
+        commandCapacity = cap;
+    }
+    if (quadCount + quads > quadCapacity)
+    {
+        int cap = quadCapacity > 0 ? quadCapacity : RQ_MIN_ITEMS;
+        while (cap < quadCount + quads)
+            cap *= 2;
+        if (!resizeBuffer((void **)&vertices, cap, 4 * sizeof(SDL_Vertex)) ||
+            !resizeBuffer((void **)&merged, cap, 4 * sizeof(SDL_Vertex)))
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para la cola de render\n");
+            return false;
+        }
+        quadCapacity = cap;
+    }
+    return true;
+}
+
+static Uint32 textureHash(const SDL_Texture *texture)
+{
+    return (Uint32)(((uintptr_t)texture >> 4) * 2654435761u);
+}
+
+// Entrada de generacion de una textura (NULL si nunca cambio). Con 'create'
+// la registra; si la tabla se llena se vacia y se redibuja todo una vez.
+static TextureGeneration *findGeneration(SDL_Texture *texture, bool create)
+{
+    if (!create && generationCount == 0)
+        return NULL;
+    if (create && generationCount >= RQ_GENERATIONS / 2)
+    {
+        memset(generations, 0, sizeof(generations));
+        generationCount = 0;
+        cacheValid = false;
+    }
+
+    Uint32 h = textureHash(texture) & (RQ_GENERATIONS - 1);
+    for (int probe = 0; probe < RQ_GENERATIONS; probe++)
+    {
+        TextureGeneration *g = &generations[(h + (Uint32)probe) & (RQ_GENERATIONS - 1)];
+        if (g->texture == texture)
+            return g;
+        if (!g->texture)
+        {
+            if (!create)
+                return NULL;
+            g->texture = texture;
+            generationCount++;
+            return g;
+        }
+    }
+    return NULL;
+}
+
+// Busca (o registra en este frame) una textura. Retorna NULL si no es valida.
+static TextureSlot *textureSlot(SDL_Texture *texture)
+{
+    Uint32 h = textureHash(texture) & (RQ_TEXTURE_SLOTS - 1);
+    for (int probe = 0; probe < RQ_TEXTURE_SLOTS; probe++)
+    {
+        TextureSlot *slot = &textureSlots[(h + (Uint32)probe) & (RQ_TEXTURE_SLOTS - 1)];
+        if (slot->frame == frameStamp && slot->texture == texture)
+            return slot;
+        if (slot->frame != frameStamp)
+        {
+            int w = 0, h2 = 0;
+            GetTextureSize(texture, &w, &h2);
+            if (w <= 0 || h2 <= 0)
+                return NULL;
+            slot->texture = texture;
+            slot->frame   = frameStamp;
+            slot->id      = textureCount < RQ_MAX_TEXTURES ? (Uint16)textureCount++ : RQ_NO_ID;
+            slot->blend   = SDL_BLENDMODE_NONE;
+            SDL_GetTextureBlendMode(texture, &slot->blend);
+            const TextureGeneration *g = findGeneration(texture, false);
+            slot->generation = g ? g->generation : 0;
+            slot->inv_w   = 1.0f / (float)w;
+            slot->inv_h   = 1.0f / (float)h2;
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+// Los blend modes de SDL son flags: se comprimen a 4 bits para la clave.
+static Uint64 blendCode(SDL_BlendMode blend)
+{
+    switch (blend)
+    {
+        case SDL_BLENDMODE_NONE:  return 0;
+        case SDL_BLENDMODE_BLEND: return 1;
+        case SDL_BLENDMODE_ADD:   return 2;
+        case SDL_BLENDMODE_MOD:   return 3;
+        case SDL_BLENDMODE_MUL:   return 4;
+        default:                  return 15;
+    }
+}
+
+// Registra el comando de los ultimos 'quads' quads escritos.
+static void pushCommand(TextureSlot *slot, int quads, Uint8 layer, Uint32 depth)
+{
+    int c = commandCount++;
+    Uint64 key = ((Uint64)layer << RQ_LAYER_SHIFT)
+               | ((Uint64)slot->id << RQ_TEXTURE_SHIFT)
+               | (blendCode(slot->blend) << RQ_BLEND_SHIFT)
+               | (Uint64)depth;
+    commands[c] = (RenderCommand){slot->texture, slot->blend, quadCount, quads, key, slot->generation};
+    items[c].key = key;
+    items[c].command = c;
+    quadCount += quads;
+
+    pending.commands++;
+    pending.quads += quads;
+    if (lastSubmitted && slot->texture != lastSubmitted)
+        pending.unsorted_texture_switches++;
+    lastSubmitted = slot->texture;
+}
+
+// Radix sort LSD de 8 bits por pasada (estable). Las pasadas donde todas
+// las claves comparten el byte se saltean. Retorna el buffer ordenado.
+static SortItem *radixSort(SortItem *a, SortItem *b, int n)
+{
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        int count[256] = {0};
+        for (int i = 0; i < n; i++)
+            count[(a[i].key >> shift) & 0xFF]++;
+        if (count[(a[0].key >> shift) & 0xFF] == n)
+            continue;
+
+        int sum = 0;
+        for (int d = 0; d < 256; d++)
+        {
+            int c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++)
+            b[count[(a[i].key >> shift) & 0xFF]++] = a[i];
+
+        SortItem *t = a;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Despacha en orden de clave los comandos que tocan 'clip' (NULL = todos),
+// una llamada por tramo de textura + blend mode.
+static void dispatch(const SortItem *sorted, const int *idx, const SDL_Rect *clip)
+{
+    SDL_Texture *prevTexture = NULL;
+    SDL_BlendMode prevBlend  = SDL_BLENDMODE_NONE;
+    int runStart = 0, runQuads = 0;
+    for (int i = 0; i <= commandCount; i++)
+    {
+        const RenderCommand *cmd = NULL;
+        if (i < commandCount)
+        {
+            int c = sorted[i].command;
+            if (clip && !SDL_HasIntersection(&bounds[c], clip))
+                continue;
+            cmd = &commands[c];
+        }
+        bool sameState = cmd && runQuads > 0 && cmd->texture == prevTexture && cmd->blend == prevBlend;
+        if (!sameState && runQuads > 0)
+        {
+            SDL_RenderGeometry(render, prevTexture, &merged[runStart * 4], runQuads * 4, idx, runQuads * 6);
+            pending.draw_calls++;
+            runStart += runQuads;
+            runQuads = 0;
+        }
+        if (!cmd)
+            break;
+
+        if (runQuads == 0)
+        {
+            if (prevTexture && cmd->texture != prevTexture)
+                pending.texture_switches++;
+            if (prevTexture && cmd->blend != prevBlend)
+                pending.blend_switches++;
+            prevTexture = cmd->texture;
+            prevBlend   = cmd->blend;
+        }
+        memcpy(&merged[(runStart + runQuads) * 4], &vertices[cmd->first_quad * 4],
+               (size_t)cmd->quad_count * 4 * sizeof(SDL_Vertex));
+        runQuads += cmd->quad_count;
+    }
+}
+
+// FNV-1a sobre la textura (puntero y generacion), el blend, la clave y
+// los vertices del comando.
+static Uint64 commandSignature(int c)
+{
+    const RenderCommand *cmd = &commands[c];
+    Uint64 h = 14695981039346656037ULL;
+    const Uint8 *parts[4] = {(const Uint8 *)&cmd->texture, (const Uint8 *)&cmd->generation,
+                             (const Uint8 *)&cmd->key, (const Uint8 *)&vertices[cmd->first_quad * 4]};
+    size_t sizes[4] = {sizeof(cmd->texture), sizeof(cmd->generation), sizeof(cmd->key),
+                       (size_t)cmd->quad_count * 4 * sizeof(SDL_Vertex)};
+    for (int p = 0; p < 4; p++)
+        for (size_t i = 0; i < sizes[p]; i++)
+            h = (h ^ parts[p][i]) * 1099511628211ULL;
+    return h ^ (Uint64)cmd->blend;
+}
+
+// Caja en pantalla (pixeles enteros que toca) de los vertices del comando.
+static SDL_Rect commandBounds(int c)
+{
+    const RenderCommand *cmd = &commands[c];
+    const SDL_Vertex *v = &vertices[cmd->first_quad * 4];
+    float x0 = v[0].position.x, y0 = v[0].position.y, x1 = x0, y1 = y0;
+    for (int i = 1; i < cmd->quad_count * 4; i++)
+    {
+        x0 = SDL_min(x0, v[i].position.x);
+        y0 = SDL_min(y0, v[i].position.y);
+        x1 = SDL_max(x1, v[i].position.x);
+        y1 = SDL_max(y1, v[i].position.y);
+    }
+    int ix = (int)floorf(x0), iy = (int)floorf(y0);
+    return (SDL_Rect){ix, iy, (int)ceilf(x1) - ix, (int)ceilf(y1) - iy};
+}
+
+static int rectArea(const SDL_Rect *r)
+{
+    return r->w * r->h;
+}
+
+// Agrega una region sucia (recortada a la pantalla). Las que se tocan se
+// fusionan; con la lista llena se fusiona con la que menos area agrega.
+static void addDirty(SDL_Rect r)
+{
+    SDL_Rect screen = {0, 0, cacheW, cacheH};
+    if (!SDL_IntersectRect(&r, &screen, &r))
+        return;
+
+    for (int i = 0; i < dirtyCount; i++)
+    {
+        SDL_Rect grown = {dirty[i].x - 1, dirty[i].y - 1, dirty[i].w + 2, dirty[i].h + 2};
+        if (SDL_HasIntersection(&grown, &r))
+        {
+            SDL_Rect u;
+            SDL_UnionRect(&dirty[i], &r, &u);
+            dirty[i] = dirty[--dirtyCount];
+            addDirty(u);
+            return;
+        }
+    }
+    if (dirtyCount < RQ_MAX_DIRTY)
+    {
+        dirty[dirtyCount++] = r;
+        return;
+    }
+
+    int best = 0, bestGrowth = 0;
+    for (int i = 0; i < dirtyCount; i++)
+    {
+        SDL_Rect u;
+        SDL_UnionRect(&dirty[i], &r, &u);
+        int growth = rectArea(&u) - rectArea(&dirty[i]);
+        if (i == 0 || growth < bestGrowth)
+        {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+    SDL_Rect u;
+    SDL_UnionRect(&dirty[best], &r, &u);
+    dirty[best] = dirty[--dirtyCount];
+    addDirty(u);
+}
+
+static bool ensureDrawn(int count)
+{
+    if (count <= drawnCapacity)
+        return true;
+    int cap = drawnCapacity > 0 ? drawnCapacity : RQ_MIN_ITEMS;
+    while (cap < count)
+        cap *= 2;
+    if (!resizeBuffer((void **)&drawn, cap, sizeof(DrawnCommand)))
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para la cola de render\n");
+        return false;
+    }
+    drawnCapacity = cap;
+    return true;
+}
+
+// Cruza las firmas del frame con las del anterior (ambas ordenadas) y
+// acumula como sucio lo que cambio (todo si el frame retenido no es valido).
+// Retorna false si este frame no pudo guardarse como referencia.
+static bool collectDirty(void)
+{
+    dirtyCount = 0;
+    for (int c = 0; c < commandCount; c++)
+    {
+        bounds[c] = commandBounds(c);
+        sigItems[c] = (SortItem){commandSignature(c), c};
+    }
+    const SortItem *sorted = commandCount > 0 ? radixSort(sigItems, sigTmp, commandCount) : sigItems;
+
+    int i = 0, j = 0;
+    while (i < commandCount || j < drawnCount)
+    {
+        if (j >= drawnCount || (i < commandCount && sorted[i].key < drawn[j].signature))
+            addDirty(bounds[sorted[i++].command]);
+        else if (i >= commandCount || drawn[j].signature < sorted[i].key)
+            addDirty(drawn[j++].bounds);
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+
+    // El frame actual pasa a ser la referencia del siguiente. Sin memoria
+    // para guardarlo, el proximo frame no puede compararse y se redibuja todo
+    bool stored = ensureDrawn(commandCount);
+    if (stored)
+    {
+        for (int c = 0; c < commandCount; c++)
+            drawn[c] = (DrawnCommand){sorted[c].key, bounds[sorted[c].command]};
+        drawnCount = commandCount;
+    }
+    else
+        drawnCount = 0;
+
+    int area = 0;
+    for (int d = 0; d < dirtyCount; d++)
+        area += rectArea(&dirty[d]);
+    if (!cacheValid || area * 100 >= cacheW * cacheH * RQ_FULL_REDRAW)
+    {
+        dirtyCount = 1;
+        dirty[0] = (SDL_Rect){0, 0, cacheW, cacheH};
+    }
+    return stored;
+}
+
+// Redibuja solo las regiones sucias sobre el frame retenido y lo copia al target actual.
+static void flushDirty(const SortItem *sorted, const int *idx)
+{
+    bool stored = collectDirty();
+
+    SDL_Texture *prevTarget = SDL_GetRenderTarget(render);
+    float prevSx, prevSy;
+    Uint8 r, g, b, a;
+    SDL_BlendMode prevBlend = SDL_BLENDMODE_BLEND;
+    SDL_Rect prevClip;
+    bool clipped = SDL_RenderIsClipEnabled(render);
+    SDL_RenderGetScale(render, &prevSx, &prevSy);
+    SDL_GetRenderDrawColor(render, &r, &g, &b, &a);
+    SDL_GetRenderDrawBlendMode(render, &prevBlend);
+    SDL_RenderGetClipRect(render, &prevClip);
+    SDL_SetRenderTarget(render, cache);
+    SDL_RenderSetScale(render, 1.0f, 1.0f);
+    SDL_SetRenderDrawBlendMode(render, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+
+    int pixels = 0;
+    for (int d = 0; d < dirtyCount; d++)
+    {
+        SDL_RenderSetClipRect(render, &dirty[d]);
+        SDL_RenderFillRect(render, &dirty[d]);
+        if (idx)
+            dispatch(sorted, idx, &dirty[d]);
+        pixels += rectArea(&dirty[d]);
+    }
+    SDL_RenderSetClipRect(render, NULL);
+    cacheValid = stored;
+
+    // El resto del frame (debug, HUD, GUI) dibuja con el estado del llamador
+    SDL_SetRenderTarget(render, prevTarget);
+    SDL_RenderSetScale(render, prevSx, prevSy);
+    SDL_SetRenderDrawBlendMode(render, prevBlend);
+    SDL_SetRenderDrawColor(render, r, g, b, a);
+    SDL_RenderSetClipRect(render, clipped ? &prevClip : NULL);
+    SDL_RenderCopy(render, cache, NULL, NULL);
+
+    pending.dirty_rects = dirtyCount;
+    pending.redrawn_pct = cacheW > 0 && cacheH > 0 ? 100.0f * (float)pixels / (float)(cacheW * cacheH) : 0.0f;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+void RenderQueue_Begin(void)
+{
+    commandCount  = 0;
+    quadCount     = 0;
+    textureCount  = 0;
+    lastSubmitted = NULL;
+    pending       = (RenderQueueStats){0};
+    queueOpen     = true;
+
+    // Las entradas de frames anteriores quedan libres sin recorrer la tabla
+    if (++frameStamp == 0)
+    {
+        memset(textureSlots, 0, sizeof(textureSlots));
+        frameStamp = 1;
+    }
+}
+
+void RenderQueue_Sprite(const Sprite *s, Uint8 layer, Uint32 depth)
+{
+    if (!s || !s->texture)
+        return;
+    if (!queueOpen)
+    {
+        SpriteBatch_Submit(s);
+        return;
+    }
+
+    Sprite view;
+    if (!Camera_Project(s, &view))
+        return;
+
+    TextureSlot *slot = textureSlot(s->texture);
+    if (!slot || !reserve(1))
+        return;
+    SpriteBatch_BuildQuad(&vertices[quadCount * 4], &view, slot->inv_w, slot->inv_h);
+    pushCommand(slot, 1, layer, depth);
+}
+
+void RenderQueue_Quads(SDL_Texture *texture, const SDL_Vertex *verts, int count, Uint8 layer, Uint32 depth)
+{
+    if (!texture || !verts || count <= 0)
+        return;
+    if (!queueOpen)
+    {
+        SpriteBatch_SubmitQuads(texture, verts, count);
+        return;
+    }
+
+    TextureSlot *slot = textureSlot(texture);
+    if (!slot || !reserve(count))
+        return;
+    memcpy(&vertices[quadCount * 4], verts, (size_t)count * 4 * sizeof(SDL_Vertex));
+    pushCommand(slot, count, layer, depth);
+}
+
+// Ordena, junta los tramos con el mismo estado y emite una llamada por tramo.
+void RenderQueue_Flush(void)
+{
+    if (!queueOpen)
+        return;
+    queueOpen = false;
+
+    const int *idx = commandCount > 0 ? SpriteBatch_QuadIndices(quadCount) : NULL;
+    const SortItem *sorted = items;
+    if (idx)
+    {
+        Uint64 start = SDL_GetPerformanceCounter();
+        sorted = radixSort(items, itemsTmp, commandCount);
+        pending.sort_ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    }
+
+    if (dirtyMode && cache)
+        flushDirty(sorted, idx);
+    else if (idx)
+    {
+        dispatch(sorted, idx, NULL);
+        pending.redrawn_pct = 100.0f;
+    }
+
+    stats = pending;
+    commandCount = 0;
+    quadCount = 0;
+}
+
+bool RenderQueue_SetDirtyRects(bool enabled)
+{
+    if (!enabled)
+    {
+        dirtyMode = false;
+        return true;
+    }
+
+    int w = config.WIN_W, h = config.WIN_H;
+    if (cache && (w != cacheW || h != cacheH))
+    {
+        SDL_DestroyTexture(cache);
+        cache = NULL;
+    }
+    if (!cache)
+    {
+        cache = SDL_RenderTargetSupported(render)
+              ? SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h)
+              : NULL;
+        if (!cache)
+        {
+            printDebug(LOG_WARN, "Dirty rects no disponibles (sin textura de render): %s\n", SDL_GetError());
+            dirtyMode = false;
+            return false;
+        }
+        SDL_SetTextureBlendMode(cache, SDL_BLENDMODE_NONE);
+        cacheW = w;
+        cacheH = h;
+    }
+    dirtyMode  = true;
+    cacheValid = false;
+    return true;
+}
+
+void RenderQueue_Invalidate(void)
+{
+    cacheValid = false;
+}
+
+void RenderQueue_TextureChanged(SDL_Texture *texture)
+{
+    if (!dirtyMode || !texture)
+        return;
+    TextureGeneration *g = findGeneration(texture, true);
+    if (g)
+        g->generation++;
+    else
+        cacheValid = false;
+}
+
+bool RenderQueue_IsOpen(void)
+{
+    return queueOpen;
+}
+
+bool RenderQueue_IsRetained(void)
+{
+    return dirtyMode;
+}
+
+RenderQueueStats RenderQueue_GetStats(void)
+{
+    return stats;
+}
+
+void RenderQueue_Destroy(void)
+{
+    free(commands);
+    free(items);
+    free(itemsTmp);
+    free(vertices);
+    free(merged);
+    free(bounds);
+    free(sigItems);
+    free(sigTmp);
+    free(drawn);
+    if (cache)
+        SDL_DestroyTexture(cache);
+    commands = NULL;
+    items = itemsTmp = sigItems = sigTmp = NULL;
+    vertices = merged = NULL;
+    bounds = NULL;
+    drawn = NULL;
+    cache = NULL;
+    drawnCount = drawnCapacity = 0;
+    memset(generations, 0, sizeof(generations));
+    generationCount = 0;
+    dirtyMode = cacheValid = false;
+    commandCount = commandCapacity = 0;
+    quadCount = quadCapacity = 0;
+    queueOpen = false;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file screen.c
+ * @brief Implementacion del target logico: escala entera, bandas negras
+ *        y transformacion de coordenadas de mouse.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "screen.h"
+#include "engine.h"
+#include "tools.h"
+
+// ============================================================
+// Variables privadas
+// ============================================================
+static SDL_Texture *target = NULL;
+static int logicalW = 0;
+static int logicalH = 0;
+static float scale  = 1.0f;         // Pixeles de salida por pixel logico
+static SDL_Rect dest = {0, 0, 0, 0}; // Area del target en la salida (pixeles)
+static float pixelRatioX = 1.0f;    // Pixeles de salida por unidad de ventana (high DPI)
+static float pixelRatioY = 1.0f;
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Mayor escala entera que entra en la salida; si la salida es mas chica
+// que la resolucion logica se reduce (fraccionaria) para que entre entera.
+static void updateDest(void)
+{
+    int outW = 0, outH = 0, winW = 0, winH = 0;
+    SDL_GetRendererOutputSize(render, &outW, &outH);
+    SDL_GetWindowSize(window, &winW, &winH);
+    pixelRatioX = winW > 0 ? (float)outW / (float)winW : 1.0f;
+    pixelRatioY = winH > 0 ? (float)outH / (float)winH : 1.0f;
+
+    int fit = SDL_min(outW / logicalW, outH / logicalH);
+    if (fit >= 1)
+        scale = (float)fit;
+    else
+        scale = SDL_min((float)outW / (float)logicalW, (float)outH / (float)logicalH);
+
+    dest.w = (int)((float)logicalW * scale);
+    dest.h = (int)((float)logicalH * scale);
+    dest.x = (outW - dest.w) / 2;
+    dest.y = (outH - dest.h) / 2;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+bool Screen_Init(int w, int h, bool useTarget)
+{
+    logicalW = w;
+    logicalH = h;
+    if (!useTarget || w <= 0 || h <= 0)
+        return false;
+
+    target = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!target)
+    {
+        printDebug(LOG_WARN, "No se pudo crear el target logico (%dx%d): %s. Se escala por render\n", w, h, SDL_GetError());
+        return false;
+    }
+    // Pixeles nitidos al ampliar
+    SDL_SetTextureScaleMode(target, SDL_ScaleModeNearest);
+    SDL_RenderSetScale(render, 1.0f, 1.0f);
+    updateDest();
+    printDebug(LOG_INFO, "Target logico %dx%d, escala x%.2f\n", w, h, scale);
+    return true;
+}
+
+void Screen_Resize(int winW, int winH)
+{
+    if (target)
+    {
+        updateDest();
+        return;
+    }
+    // Sin target: cada dibujo lo escala el renderer
+    float sx = (float)winW / logicalW; // ej: 1920 / 960 = 2.0 <- Escala horizontal del juego
+    float sy = (float)winH / logicalH; // Escala vertical del juego
+    SDL_RenderSetScale(render, sx, sy);
+}
+
+void Screen_BeginFrame(void)
+{
+    if (target)
+        SDL_SetRenderTarget(render, target);
+}
+
+void Screen_Present(void)
+{
+    if (target)
+    {
+        SDL_SetRenderTarget(render, NULL);
+        SDL_SetRenderDrawColor(render, 0, 0, 0, 255);
+        SDL_RenderClear(render);
+        SDL_RenderCopy(render, target, NULL, &dest);
+    }
+    SDL_RenderPresent(render);
+}
+
+void Screen_WindowToLogical(int *x, int *y)
+{
+    if (target)
+    {
+        *x = (int)SDL_floorf(((float)*x * pixelRatioX - (float)dest.x) / scale);
+        *y = (int)SDL_floorf(((float)*y * pixelRatioY - (float)dest.y) / scale);
+        return;
+    }
+    float sx, sy;
+    SDL_RenderGetScale(render, &sx, &sy);
+    *x = (int)(*x / sx);
+    *y = (int)(*y / sy);
+}
+
+void Screen_WindowDeltaToLogical(int *dx, int *dy)
+{
+    float sx = scale / pixelRatioX, sy = scale / pixelRatioY;
+    if (!target)
+        SDL_RenderGetScale(render, &sx, &sy);
+    *dx = (int)(*dx / sx);
+    *dy = (int)(*dy / sy);
+}
+
+bool Screen_UsesTarget(void)
+{
+    return target != NULL;
+}
+
+void Screen_Destroy(void)
+{
+    if (target)
+        SDL_DestroyTexture(target);
+    target = NULL;
+    scale = 1.0f;
+}
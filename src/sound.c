@@ -8,39 +8,81 @@
 // ============================================================
 #include "sound.h"
 #include "config.h"
+#include "jobs.h"
+#include "mixer.h"
+#include "pack.h"
 #include "tools.h"
 
 // ============================================================
 // Variables privadas
 // ============================================================
 
-#define MAX_CHANNELS 16
-
 static const char *audioExtensions[] = {".wav", ".ogg", ".mp3"};
 
-typedef struct {
-    Mix_Chunk *chunk;
-    bool in_use;
-} ChannelData;
-
-static ChannelData channel_chunks[MAX_CHANNELS] = {0};
+static sfx *bank = NULL; // Banco global de efectos (Sound_InitBank)
 
 // ============================================================
 // Funciones internas (static)
 // ============================================================
 
-// Callback invocado por SDL_mixer cuando un canal termina de reproducir.
-// Libera el chunk asociado y marca el canal como disponible.
-static void channelDoneCallback(int channel)
+// Carga un efecto desde el paquete de assets (PCM ya decodificado, sin copia)
+// o, si no esta ahi, desde el archivo suelto.
+static Mix_Chunk *loadChunk(const char *fullpath)
+{
+    Mix_Chunk *chunk = Pack_CreateChunk(Pack_Find(fullpath));
+    return chunk ? chunk : Mix_LoadWAV(fullpath);
+}
+
+// Job de initSfxLib: decodifica un archivo de audio en su slot.
+typedef struct {
+    const char *name;
+    Mix_Chunk **out;
+    char error[256]; // Error del worker (vacio si no hubo), se informa en el hilo principal
+} SfxLoadJob;
+
+// Corre en un worker: no llama a printDebug (no es reentrante).
+static void loadSfxJob(void *data)
 {
-    if (channel >= 0 && channel < MAX_CHANNELS && channel_chunks[channel].in_use)
+    SfxLoadJob *job = data;
+    char fullpath[PATH_SIZE(job->name)];
+    snprintf(fullpath, sizeof(fullpath), "%s%s", SFX_DIR, job->name);
+    *job->out = loadChunk(fullpath);
+    if(!*job->out)
+        snprintf(job->error, sizeof(job->error), "Error al cargar %s: %s", fullpath, Mix_GetError());
+}
+
+// Arma la tabla hash de nombres de una libreria (direccionamiento abierto,
+// sondeo lineal, ocupacion <= 50%). Sin memoria, findSfx busca en lineal.
+static void buildSfxIndex(sfx *lib)
+{
+    int size = 16;
+    while (size < lib->n * 2)
+        size *= 2;
+
+    lib->hashes = malloc((size_t)lib->n * sizeof(Uint64));
+    lib->slots = malloc((size_t)size * sizeof(int));
+    if (!lib->hashes || !lib->slots)
     {
-        if (channel_chunks[channel].chunk)
-        {
-            Mix_FreeChunk(channel_chunks[channel].chunk);
-            channel_chunks[channel].chunk = NULL;
-        }
-        channel_chunks[channel].in_use = false;
+        printDebug(LOG_WARN, "No se pudo crear el indice de sonidos (busqueda lineal)\n");
+        free(lib->hashes);
+        free(lib->slots);
+        lib->hashes = NULL;
+        lib->slots = NULL;
+        return;
+    }
+
+    lib->slot_mask = size - 1;
+    for (int i = 0; i < size; i++)
+        lib->slots[i] = -1;
+    for (int i = 0; i < lib->n; i++)
+    {
+        lib->hashes[i] = hashString(lib->names[i]);
+        if (!lib->names[i])
+            continue; // Sin nombre no se puede buscar
+        int slot = (int)(lib->hashes[i] & (Uint64)lib->slot_mask);
+        while (lib->slots[slot] != -1)
+            slot = (slot + 1) & lib->slot_mask;
+        lib->slots[slot] = i;
     }
 }
 
@@ -49,8 +91,14 @@ static void channelDoneCallback(int channel)
 // ============================================================
 
 // Inicializa el subsistema de audio de SDL y abre el dispositivo de mezcla (44100 Hz, stereo).
+// Si ya esta abierto no lo vuelve a abrir.
 bool initAudio(void)
 {
+    int freq = 0, channels = 0;
+    Uint16 format = 0;
+    if (Mix_QuerySpec(&freq, &format, &channels))
+        return true;
+
     if (SDL_WasInit(SDL_INIT_AUDIO) == 0)
     {
         if (SDL_Init(SDL_INIT_AUDIO) < 0)
@@ -65,12 +113,16 @@ bool initAudio(void)
         SDL_QuitSubSystem(SDL_INIT_AUDIO);
         return false;
     }
+    // Mezclador por software opcional: si no engancha quedan los canales de SDL_mixer
+    if (config.mixer_voices > 0 && Mixer_Init(config.mixer_voices) && !Mixer_Attach())
+        Mixer_Quit();
     return true;
 }
 
 // Cierra el dispositivo de mezcla y libera el subsistema de audio de SDL.
 void quitAudio(void)
 {
+    Mixer_Quit();
     Mix_CloseAudio();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
 }
@@ -79,39 +131,95 @@ void quitAudio(void)
 // Reproduccion
 // ============================================================
 
-// Reproduce un efecto de sonido una vez y lo libera automaticamente al finalizar
-// mediante el callback channelDoneCallback.
+// Reproduce un efecto del banco (nombre conservado por compatibilidad).
 void playAndFreeSfx(const char *sound)
 {
-    if (!initAudio())
-    {
-        printDebug(LOG_WARN, "Olvidaste iniciar el audio! o no esta activo...: %s\n", Mix_GetError());
-        return;
-    }
+    Sound_Play(sound);
+}
 
-    char path[PATH_SIZE(sound)];
-    snprintf(path, sizeof(path), "%s%s", SFX_DIR, sound);
+// ============================================================
+// Banco de sonidos
+// ============================================================
+
+// Carga todos los efectos del directorio una sola vez.
+bool Sound_InitBank(char *path)
+{
+    Sound_QuitBank();
+    bank = initSfxLib(path);
+    return bank != NULL;
+}
 
-    Mix_Chunk *sfx_chunk = Mix_LoadWAV(path);
-    if(!sfx_chunk) {
-        printDebug(LOG_ERROR, "Error al cargar %s: %s\n", path, Mix_GetError());
+// Libera el banco (los canales que lo usan se detienen antes).
+void Sound_QuitBank(void)
+{
+    if (!bank)
         return;
-    }
+    Mix_HaltChannel(-1);
+    Mixer_Halt();
+    freeSfxLib(bank);
+    bank = NULL;
+}
 
-    Mix_ChannelFinished(channelDoneCallback);
+int Sound_Find(const char *name)
+{
+    return findSfx(bank, name);
+}
 
-    int channel = Mix_PlayChannel(-1, sfx_chunk, 0);
-    if (channel == -1) {
-        printDebug(LOG_ERROR, "Error al reproducir %s: %s\n", path, Mix_GetError());
-        Mix_FreeChunk(sfx_chunk);
-        return;
+int Sound_Play(const char *name)
+{
+    int id = findSfx(bank, name);
+    if (id < 0)
+    {
+        printDebug(LOG_WARN, "El efecto '%s' no esta en el banco de sonidos\n", name ? name : "(null)");
+        return -1;
     }
+    return Sound_PlayId(id);
+}
 
-    if (channel >= 0 && channel < MAX_CHANNELS)
+// Sin disco ni reservas: solo asigna un canal libre (o una voz del
+// mezclador por software) al chunk ya cargado.
+int Sound_PlayId(int id)
+{
+    if (!bank || id < 0 || id >= bank->n || !bank->chunks[id])
+        return -1;
+
+    if (Mixer_IsActive())
     {
-        channel_chunks[channel].chunk = sfx_chunk;
-        channel_chunks[channel].in_use = true;
+        int voice = Mixer_Play(bank->chunks[id], 1.0f, 0.0f);
+        if (voice == -1)
+            printDebug(LOG_WARN, "Error al reproducir %s: cola del mezclador llena\n", bank->names[id]);
+        return voice;
     }
+
+    // Mix_Volume queda en el canal: se vuelve a ganancia completa antes de
+    // reusarlo, asi Sound_SetGain afecta solo a una reproduccion (como en el mezclador)
+    int channel = Mix_GroupAvailable(-1);
+    if (channel != -1)
+        Mix_Volume(channel, MIX_MAX_VOLUME);
+    channel = Mix_PlayChannel(channel, bank->chunks[id], 0);
+    if (channel == -1)
+        printDebug(LOG_WARN, "Error al reproducir %s: %s\n", bank->names[id], Mix_GetError());
+    return channel;
+}
+
+void Sound_Stop(int channel)
+{
+    if (channel < 0)
+        return;
+    if (Mixer_IsActive())
+        Mixer_Stop(channel);
+    else
+        Mix_HaltChannel(channel);
+}
+
+void Sound_SetGain(int channel, float gain)
+{
+    if (channel < 0)
+        return;
+    if (Mixer_IsActive())
+        Mixer_SetGain(channel, gain);
+    else
+        Mix_Volume(channel, (int)(SDL_max(0.0f, SDL_min(gain, 1.0f)) * MIX_MAX_VOLUME));
 }
 
 // ============================================================
@@ -123,7 +231,9 @@ void playAndFreeSfx(const char *sound)
 sfx *initSfxLib(char *path)
 {
     int sfx_count = 0;
-    char **sounds = getFilesFromDir(path, &sfx_count, audioExtensions, ARRAY_L(audioExtensions), SOUND);
+    char **sounds = Pack_ListDir(path, PACK_SOUND, &sfx_count);
+    if(!sounds)
+        sounds = getFilesFromDir(path, &sfx_count, audioExtensions, ARRAY_L(audioExtensions), SOUND);
     if(!sounds)
     {
         printDebug(LOG_ERROR, "No se pudo inicializar la libreria sfx en la carpeta '%s'\n", path);
@@ -138,29 +248,54 @@ sfx *initSfxLib(char *path)
     }
 
     sfx *cur = calloc(1, sizeof(sfx));
-    if(!cur)
+    if(!cur) {
+        freeStringArray(sounds, sfx_count);
         return NULL;
+    }
 
     cur->n = sfx_count;
     cur->chunks = calloc((size_t)sfx_count, sizeof(Mix_Chunk *));
     if(!cur->chunks) {
+        freeStringArray(sounds, sfx_count);
         free(cur);
         return NULL;
     }
 
+    // Los workers no escriben en el log: el formato del paquete se avisa aca
+    if(Pack_IsOpen() && !Pack_AudioMatches())
+        printDebug(LOG_WARN, "El formato del mixer no coincide con el del paquete: se cargan WAV sueltos\n");
+
+    // Cada archivo se decodifica en un job; sin workers se cargan en serie
+    SfxLoadJob *jobs = calloc((size_t)sfx_count, sizeof(SfxLoadJob));
+    JobCounter loaded = {0};
     for(int i = 0; i < sfx_count; i++)
     {
         if(!sounds[i])
             continue;
-        char fullpath[PATH_SIZE(sounds[i])];
-        snprintf(fullpath, sizeof(fullpath), "%s%s", SFX_DIR, sounds[i]);
-        cur->chunks[i] = Mix_LoadWAV(fullpath);
-        if(!cur->chunks[i])
-            printDebug(LOG_WARN, "Error al cargar %s: %s\n", fullpath, Mix_GetError());
-        if (sounds[i])
-            free(sounds[i]);
-    }
-    free(sounds);
+        if(jobs)
+        {
+            jobs[i] = (SfxLoadJob){sounds[i], &cur->chunks[i], ""};
+            Jobs_Run(loadSfxJob, &jobs[i], &loaded);
+        }
+        else
+        {
+            SfxLoadJob job = {sounds[i], &cur->chunks[i], ""};
+            loadSfxJob(&job);
+            if(job.error[0])
+                printDebug(LOG_WARN, "%s\n", job.error);
+        }
+    }
+    Jobs_Wait(&loaded);
+    for(int i = 0; jobs && i < sfx_count; i++)
+    {
+        if(jobs[i].error[0])
+            printDebug(LOG_WARN, "%s\n", jobs[i].error);
+    }
+    free(jobs);
+
+    // Los nombres quedan en la libreria para buscar por nombre
+    cur->names = sounds;
+    buildSfxIndex(cur);
     return cur;
 }
 
@@ -212,6 +347,32 @@ music *initMusicLib(char *path)
     return cur;
 }
 
+// Busca un efecto por nombre: hash -> slot, confirmando con el nombre.
+int findSfx(const sfx *lib, const char *name)
+{
+    if (!lib || !name)
+        return -1;
+
+    if (!lib->slots)
+    {
+        for (int i = 0; i < lib->n; i++)
+        {
+            if (lib->names[i] && !strcmp(lib->names[i], name))
+                return i;
+        }
+        return -1;
+    }
+
+    Uint64 hash = hashString(name);
+    for (int slot = (int)(hash & (Uint64)lib->slot_mask); lib->slots[slot] != -1; slot = (slot + 1) & lib->slot_mask)
+    {
+        int i = lib->slots[slot];
+        if (lib->hashes[i] == hash && lib->names[i] && !strcmp(lib->names[i], name))
+            return i;
+    }
+    return -1;
+}
+
 // Libera todos los chunks de una libreria de efectos de sonido y la estructura misma.
 void freeSfxLib(sfx *cur)
 {
@@ -226,7 +387,12 @@ void freeSfxLib(sfx *cur)
         }
         free(cur->chunks);
     }
+    if(cur->names)
+        freeStringArray(cur->names, cur->n);
+    free(cur->hashes);
+    free(cur->slots);
     cur->chunks = NULL;
+    cur->names = NULL;
     cur->n = 0;
     free(cur);
 }
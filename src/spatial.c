@@ -0,0 +1,259 @@
+/**
+ * @file spatial.c
+ * @brief Implementacion de la grilla uniforme: alta, movimiento y consulta
+ *        de elementos por caja.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "spatial.h"
+#include "tools.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================
+// Variables privadas
+// ============================================================
+
+#define SPATIAL_MIN_IDS   4   // Capacidad inicial de una celda
+#define SPATIAL_MIN_ITEMS 256 // Capacidad inicial de ids
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Celda de una coordenada, recortada a la grilla.
+static int cellCoord(float v, float origin, float size, int count)
+{
+    int c = (int)floorf((v - origin) / size);
+    if (c < 0) return 0;
+    if (c >= count) return count - 1;
+    return c;
+}
+
+// Rango inclusivo de celdas que toca una caja.
+static SDL_Rect cellRange(const SpatialGrid *grid, SDL_FRect box)
+{
+    return (SDL_Rect){
+        cellCoord(box.x, grid->bounds.x, grid->cell_size, grid->cols),
+        cellCoord(box.y, grid->bounds.y, grid->cell_size, grid->rows),
+        cellCoord(box.x + box.w, grid->bounds.x, grid->cell_size, grid->cols),
+        cellCoord(box.y + box.h, grid->bounds.y, grid->cell_size, grid->rows)
+    };
+}
+
+static bool overlaps(SDL_FRect a, SDL_FRect b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+// Crece las columnas de ids hasta cubrir 'id'.
+static bool reserveItems(SpatialGrid *grid, int id)
+{
+    if (id < grid->item_capacity)
+        return true;
+
+    int cap = grid->item_capacity > 0 ? grid->item_capacity : SPATIAL_MIN_ITEMS;
+    while (cap <= id)
+        cap *= 2;
+
+    SDL_FRect *box   = realloc(grid->item_box, (size_t)cap * sizeof(SDL_FRect));
+    if (box) grid->item_box = box;
+    SDL_Rect *cells  = realloc(grid->item_cells, (size_t)cap * sizeof(SDL_Rect));
+    if (cells) grid->item_cells = cells;
+    Uint32 *stamp    = realloc(grid->item_stamp, (size_t)cap * sizeof(Uint32));
+    if (stamp) grid->item_stamp = stamp;
+    Uint8 *used      = realloc(grid->item_used, (size_t)cap * sizeof(Uint8));
+    if (used) grid->item_used = used;
+    if (!box || !cells || !stamp || !used)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para %d ids de la grilla\n", cap);
+        return false;
+    }
+
+    size_t added = (size_t)(cap - grid->item_capacity);
+    memset(grid->item_stamp + grid->item_capacity, 0, added * sizeof(Uint32));
+    memset(grid->item_used + grid->item_capacity, 0, added * sizeof(Uint8));
+    grid->item_capacity = cap;
+    return true;
+}
+
+static bool cellAdd(SpatialCell *cell, int id)
+{
+    if (cell->count >= cell->capacity)
+    {
+        int cap = cell->capacity > 0 ? cell->capacity * 2 : SPATIAL_MIN_IDS;
+        int *ids = realloc(cell->ids, (size_t)cap * sizeof(int));
+        if (!ids)
+            return false;
+        cell->ids = ids;
+        cell->capacity = cap;
+    }
+    cell->ids[cell->count++] = id;
+    return true;
+}
+
+// Borrado por swap con el ultimo (el orden dentro de la celda no importa).
+static void cellRemove(SpatialCell *cell, int id)
+{
+    for (int i = 0; i < cell->count; i++)
+    {
+        if (cell->ids[i] == id)
+        {
+            cell->ids[i] = cell->ids[--cell->count];
+            return;
+        }
+    }
+}
+
+static void unlinkCells(SpatialGrid *grid, int id, SDL_Rect r)
+{
+    for (int cy = r.y; cy <= r.h; cy++)
+        for (int cx = r.x; cx <= r.w; cx++)
+            cellRemove(&grid->cells[cy * grid->cols + cx], id);
+}
+
+static bool linkCells(SpatialGrid *grid, int id, SDL_Rect r)
+{
+    for (int cy = r.y; cy <= r.h; cy++)
+        for (int cx = r.x; cx <= r.w; cx++)
+            if (!cellAdd(&grid->cells[cy * grid->cols + cx], id))
+            {
+                printDebug(LOG_ERROR, "No se pudo agregar el id %d a la grilla\n", id);
+                return false;
+            }
+    return true;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+bool Spatial_Init(SpatialGrid *grid, SDL_FRect bounds, float cellSize)
+{
+    *grid = (SpatialGrid){0};
+    if (bounds.w <= 0.0f || bounds.h <= 0.0f || cellSize <= 0.0f)
+    {
+        printDebug(LOG_ERROR, "Grilla invalida: %.0fx%.0f con celdas de %.1f\n", bounds.w, bounds.h, cellSize);
+        return false;
+    }
+
+    grid->bounds    = bounds;
+    grid->cell_size = cellSize;
+    grid->cols      = SDL_max(1, (int)ceilf(bounds.w / cellSize));
+    grid->rows      = SDL_max(1, (int)ceilf(bounds.h / cellSize));
+    grid->cells     = calloc((size_t)grid->cols * (size_t)grid->rows, sizeof(SpatialCell));
+    if (!grid->cells)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para la grilla (%dx%d)\n", grid->cols, grid->rows);
+        return false;
+    }
+    return true;
+}
+
+void Spatial_Free(SpatialGrid *grid)
+{
+    if (grid->cells)
+    {
+        for (int i = 0; i < grid->cols * grid->rows; i++)
+            free(grid->cells[i].ids);
+    }
+    free(grid->cells);
+    free(grid->item_box);
+    free(grid->item_cells);
+    free(grid->item_stamp);
+    free(grid->item_used);
+    *grid = (SpatialGrid){0};
+}
+
+bool Spatial_Insert(SpatialGrid *grid, int id, SDL_FRect box)
+{
+    if (id < 0 || !grid->cells || !reserveItems(grid, id))
+        return false;
+    if (grid->item_used[id])
+    {
+        Spatial_Move(grid, id, box);
+        return true;
+    }
+
+    SDL_Rect r = cellRange(grid, box);
+    if (!linkCells(grid, id, r))
+    {
+        unlinkCells(grid, id, r);
+        return false;
+    }
+    grid->item_box[id]   = box;
+    grid->item_cells[id] = r;
+    grid->item_used[id]  = 1;
+    grid->item_count++;
+    return true;
+}
+
+void Spatial_Move(SpatialGrid *grid, int id, SDL_FRect box)
+{
+    if (id < 0 || id >= grid->item_capacity || !grid->item_used[id])
+        return;
+
+    grid->item_box[id] = box;
+    SDL_Rect r = cellRange(grid, box);
+    SDL_Rect old = grid->item_cells[id];
+    if (r.x == old.x && r.y == old.y && r.w == old.w && r.h == old.h)
+        return;
+
+    unlinkCells(grid, id, old);
+    if (!linkCells(grid, id, r))
+    {
+        unlinkCells(grid, id, r);
+        grid->item_used[id] = 0;
+        grid->item_count--;
+        return;
+    }
+    grid->item_cells[id] = r;
+}
+
+void Spatial_Remove(SpatialGrid *grid, int id)
+{
+    if (id < 0 || id >= grid->item_capacity || !grid->item_used[id])
+        return;
+    unlinkCells(grid, id, grid->item_cells[id]);
+    grid->item_used[id] = 0;
+    grid->item_count--;
+}
+
+// Cada id se devuelve una sola vez aunque toque varias celdas del area.
+int Spatial_Query(SpatialGrid *grid, SDL_FRect area, int *out, int max)
+{
+    if (!grid->cells || max <= 0)
+        return 0;
+
+    if (++grid->stamp == 0)
+    {
+        memset(grid->item_stamp, 0, (size_t)grid->item_capacity * sizeof(Uint32));
+        grid->stamp = 1;
+    }
+
+    SDL_Rect r = cellRange(grid, area);
+    int found = 0;
+    for (int cy = r.y; cy <= r.h; cy++)
+    {
+        for (int cx = r.x; cx <= r.w; cx++)
+        {
+            const SpatialCell *cell = &grid->cells[cy * grid->cols + cx];
+            for (int i = 0; i < cell->count; i++)
+            {
+                int id = cell->ids[i];
+                if (grid->item_stamp[id] == grid->stamp)
+                    continue;
+                grid->item_stamp[id] = grid->stamp;
+                if (!overlaps(grid->item_box[id], area))
+                    continue;
+                out[found++] = id;
+                if (found == max)
+                    return found;
+            }
+        }
+    }
+    return found;
+}
@@ -7,8 +7,11 @@
 // Includes
 // ============================================================
 #include "sprites.h"
+#include "camera.h"
 #include "engine.h"
+#include "jobs.h"
 #include "tools.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -99,6 +102,18 @@ void Anim_Reset(Animation *a)
     a->finished = false;
 }
 
+// Desplaza todos los frames (dx, dy). Sirve para llevar frames relativos a un
+// spritesheet al origen de su región dentro de una página de atlas.
+void Anim_Offset(Animation *a, int dx, int dy)
+{
+    if (!a || !a->frames) return;
+    for (int i = 0; i < a->frame_count; i++)
+    {
+        a->frames[i].x += dx;
+        a->frames[i].y += dy;
+    }
+}
+
 // Retorna el SDL_Rect del frame actual.
 SDL_Rect Anim_CurrentFrame(Animation *a)
 {
@@ -116,6 +131,130 @@ void Anim_Free(Animation *a)
     a->frame_count = 0;
 }
 
+// ============================================================
+// AnimationClip
+// ============================================================
+
+// Registro de clips: los frames de todos los clips viven en un único pool
+// contiguo y cada clip guarda su rango. Crece con realloc, por eso los clips
+// se referencian por id y no por puntero.
+static AnimationClip *clips  = NULL;
+static int clipCount         = 0;
+static int clipCapacity      = 0;
+static SDL_Rect *clipFrames  = NULL;
+static int frameCount        = 0;
+static int frameCapacity     = 0;
+
+// Registra un clip copiando sus frames. Retorna su id, o -1 si falla.
+// No registrar clips mientras otro hilo actualiza sprites (ASprite_UpdateMany).
+int Clip_Register(const SDL_Rect *frames, int count, float fps, bool loop)
+{
+    if (!frames || count <= 0 || fps <= 0.0f)
+        return -1;
+
+    if (clipCount >= clipCapacity)
+    {
+        int cap = clipCapacity > 0 ? clipCapacity * 2 : 16;
+        AnimationClip *tmp = realloc(clips, (size_t)cap * sizeof(AnimationClip));
+        if (!tmp)
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para clips de animacion\n");
+            return -1;
+        }
+        clips = tmp;
+        clipCapacity = cap;
+    }
+    if (frameCount + count > frameCapacity)
+    {
+        int cap = frameCapacity > 0 ? frameCapacity : 64;
+        while (cap < frameCount + count)
+            cap *= 2;
+        SDL_Rect *tmp = realloc(clipFrames, (size_t)cap * sizeof(SDL_Rect));
+        if (!tmp)
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para frames de animacion\n");
+            return -1;
+        }
+        clipFrames = tmp;
+        frameCapacity = cap;
+    }
+
+    memcpy(&clipFrames[frameCount], frames, (size_t)count * sizeof(SDL_Rect));
+    clips[clipCount] = (AnimationClip){
+        .first_frame    = frameCount,
+        .frame_count    = count,
+        .frame_duration = 1.0f / fps,
+        .loop           = loop
+    };
+    frameCount += count;
+    return clipCount++;
+}
+
+// Registra un clip con los frames, velocidad y loop de una animación.
+// La animación sigue siendo del caller (liberarla con Anim_Free si corresponde).
+int Clip_FromAnimation(const Animation *a)
+{
+    if (!a || a->frame_duration <= 0.0f)
+        return -1;
+    return Clip_Register(a->frames, a->frame_count, 1.0f / a->frame_duration, a->loop);
+}
+
+// Retorna el clip, o NULL si el id no es válido.
+const AnimationClip *Clip_Get(int id)
+{
+    if (id < 0 || id >= clipCount)
+        return NULL;
+    return &clips[id];
+}
+
+// Retorna el rect de un frame del clip (rect vacío si no existe).
+SDL_Rect Clip_Frame(int id, int frame)
+{
+    const AnimationClip *c = Clip_Get(id);
+    if (!c || frame < 0 || frame >= c->frame_count)
+        return (SDL_Rect){0};
+    return clipFrames[c->first_frame + frame];
+}
+
+// Frame de un clip tras 'elapsed' segundos, sin estado: mismo resultado que
+// llamar Anim_Update con esos segundos acumulados. finished (opcional) es true
+// si un clip sin loop ya pasó su último frame.
+int Clip_FrameIndexAt(int id, double elapsed, bool *finished)
+{
+    const AnimationClip *c = Clip_Get(id);
+    if (finished)
+        *finished = false;
+    if (!c || c->frame_count <= 1 || elapsed <= 0.0)
+        return 0;
+
+    double steps = floor(elapsed / (double)c->frame_duration);
+    if (c->loop)
+        return (int)fmod(steps, (double)c->frame_count);
+    if (steps >= (double)c->frame_count)
+    {
+        if (finished)
+            *finished = true;
+        return c->frame_count - 1;
+    }
+    return (int)steps;
+}
+
+int Clip_Count(void)
+{
+    return clipCount;
+}
+
+// Libera todos los clips. Los ids dejan de ser válidos.
+void Clip_FreeAll(void)
+{
+    free(clips);
+    free(clipFrames);
+    clips = NULL;
+    clipFrames = NULL;
+    clipCount = clipCapacity = 0;
+    frameCount = frameCapacity = 0;
+}
+
 // ============================================================
 // Sprite
 // ============================================================
@@ -128,6 +267,7 @@ Sprite Sprite_Create(SDL_Texture *tex, SDL_Rect src, float x, float y)
         .texture = tex,
         .src     = src,
         .dst     = {x, y, (float)src.w, (float)src.h},
+        .prev    = {x, y},
         .flip    = SDL_FLIP_NONE,
         .angle   = 0.0
     };
@@ -142,17 +282,27 @@ Sprite Sprite_CreateFull(SDL_Texture *tex, float x, float y)
         .texture = tex,
         .src     = {0, 0, w, h},
         .dst     = {x, y, (float)w, (float)h},
+        .prev    = {x, y},
         .flip    = SDL_FLIP_NONE,
         .angle   = 0.0
     };
 }
 
-// Dibuja el sprite con rotación y flip.
+// Crea un sprite desde una región de atlas (página + sub-rect).
+Sprite Sprite_CreateFromRegion(TextureRegion region, float x, float y)
+{
+    return Sprite_Create(region.texture, region.src, x, y);
+}
+
+// Dibuja el sprite con rotación y flip, proyectado con la cámara activa.
+// Los que quedan fuera de pantalla no llegan a SDL.
 void Sprite_Draw(Sprite *s)
 {
     if (!s || !s->texture) return;
-    SDL_RenderCopyExF(render, s->texture, &s->src, &s->dst,
-                      s->angle, NULL, s->flip);
+    Sprite view;
+    if (!Camera_Project(s, &view)) return;
+    SDL_RenderCopyExF(render, view.texture, &view.src, &view.dst,
+                      view.angle, NULL, view.flip);
 }
 
 // Cambia la posición del sprite.
@@ -170,71 +320,136 @@ void Sprite_SetFlip(Sprite *s, SDL_RendererFlip flip)
     s->flip = flip;
 }
 
+// Guarda la posición actual como la del inicio del tick.
+// Llamar antes de mover el sprite dentro de un tick de simulación,
+// o justo después de un Sprite_SetPos que no deba interpolarse (teletransporte).
+void Sprite_StorePrev(Sprite *s)
+{
+    if (!s) return;
+    s->prev.x = s->dst.x;
+    s->prev.y = s->dst.y;
+}
+
+// Devuelve una copia del sprite con la posición interpolada entre
+// prev (alpha = 0) y dst (alpha = 1). No modifica el original.
+Sprite Sprite_Lerp(const Sprite *s, float alpha)
+{
+    Sprite out = *s;
+    out.dst.x = s->prev.x + (s->dst.x - s->prev.x) * alpha;
+    out.dst.y = s->prev.y + (s->dst.y - s->prev.y) * alpha;
+    return out;
+}
+
 // ============================================================
 // AnimatedSprite
 // ============================================================
 
-// Crea un sprite animado. Copia el array de animaciones (toma ownership de los frames).
-// Después de llamar, no usar Anim_Free en las animaciones originales.
-AnimatedSprite ASprite_Create(SDL_Texture *tex, Animation *anims, int count, float x, float y)
+// Crea un sprite animado que reproduce un clip registrado.
+// Src rect inicial = primer frame del clip.
+AnimatedSprite ASprite_Create(SDL_Texture *tex, int clip, float x, float y)
 {
-    Animation *copy = malloc(count * sizeof(Animation));
-    if (!copy)
-    {
-        printDebug(LOG_ERROR, "No se pudo asignar memoria para AnimatedSprite\n");
-        return (AnimatedSprite){0};
-    }
-    memcpy(copy, anims, count * sizeof(Animation));
-
-    // Src rect inicial = primer frame de la primera animación
-    SDL_Rect initial = {0};
-    if (count > 0 && anims[0].frames && anims[0].frame_count > 0)
-        initial = anims[0].frames[0];
-
     return (AnimatedSprite){
-        .sprite       = Sprite_Create(tex, initial, x, y),
-        .animations   = copy,
-        .anim_count   = count,
-        .current_anim = 0
+        .sprite = Sprite_Create(tex, Clip_Frame(clip, 0), x, y),
+        .anim   = {.clip = Clip_Get(clip) ? clip : -1}
     };
 }
 
-// Cambia la animación activa. Si ya es la misma, no hace nada.
-void ASprite_Play(AnimatedSprite *as, int animIndex)
+// Cambia el clip activo (modo por ticks) y lo reinicia. Si ya es el mismo, no hace nada.
+void ASprite_Play(AnimatedSprite *as, int clip)
 {
-    if (!as || animIndex < 0 || animIndex >= as->anim_count)
+    if (!as || !Clip_Get(clip) || (as->anim.clip == clip && !as->anim.timed))
         return;
-    if (as->current_anim == animIndex)
+    as->anim = (AnimState){.clip = clip};
+    as->sprite.src = Clip_Frame(clip, 0);
+}
+
+// Reproduce un clip en modo por tiempo desde 'start' (normalmente sim_time).
+// El frame se deriva de (now - start) al dibujar; ASprite_Update lo ignora.
+void ASprite_PlayAt(AnimatedSprite *as, int clip, double start)
+{
+    if (!as || !Clip_Get(clip))
         return;
-    as->current_anim = animIndex;
-    Anim_Reset(&as->animations[animIndex]);
+    as->anim = (AnimState){.clip = clip, .timed = true, .start = start};
+    as->sprite.src = Clip_Frame(clip, 0);
 }
 
-// Actualiza la animación activa y sincroniza el src rect del sprite.
+// Frame a dibujar en el instante 'now'. En modo por ticks es el src actual.
+SDL_Rect ASprite_FrameAt(const AnimatedSprite *as, double now)
+{
+    if (!as)
+        return (SDL_Rect){0};
+    if (!as->anim.timed)
+        return as->sprite.src;
+    return Clip_Frame(as->anim.clip, Clip_FrameIndexAt(as->anim.clip, now - as->anim.start, NULL));
+}
+
+// Avanza el clip activo (misma lógica que Anim_Update) y sincroniza el src rect.
+// Los sprites en modo por tiempo no tienen nada que avanzar.
 void ASprite_Update(AnimatedSprite *as, float dt)
 {
-    if (!as || as->anim_count <= 0)
+    if (!as || as->anim.timed)
+        return;
+    const AnimationClip *c = Clip_Get(as->anim.clip);
+    AnimState *st = &as->anim;
+    if (!c || st->finished || c->frame_count <= 1)
         return;
 
-    Animation *current = &as->animations[as->current_anim];
-    Anim_Update(current, dt);
-    as->sprite.src = Anim_CurrentFrame(current);
+    st->timer += dt;
+    while (st->timer >= c->frame_duration)
+    {
+        st->timer -= c->frame_duration;
+        st->frame++;
+
+        if (st->frame >= c->frame_count)
+        {
+            if (c->loop)
+                st->frame = 0;
+            else
+            {
+                st->frame = c->frame_count - 1;
+                st->finished = true;
+                break;
+            }
+        }
+    }
+    as->sprite.src = clipFrames[c->first_frame + st->frame];
+}
+
+// Argumentos compartidos por los rangos de ASprite_UpdateMany.
+typedef struct {
+    AnimatedSprite *arr;
+    float dt;
+} ASpriteUpdateArgs;
+
+static void updateRange(int start, int end, void *data)
+{
+    ASpriteUpdateArgs *args = data;
+    for (int i = start; i < end; i++)
+        ASprite_Update(&args->arr[i], args->dt);
+}
+
+// Actualiza un array de sprites animados repartiendolo entre los workers.
+// Cada sprite es independiente, asi que los rangos no comparten estado.
+void ASprite_UpdateMany(AnimatedSprite *arr, int count, float dt)
+{
+    if (!arr || count <= 0)
+        return;
+    ASpriteUpdateArgs args = {arr, dt};
+    Jobs_ParallelFor(count, 256, updateRange, &args);
 }
 
 // Dibuja el sprite animado (frame actual con flip/rotación).
+// En modo por tiempo el frame se evalúa en sim_time.
 void ASprite_Draw(AnimatedSprite *as)
 {
     if (!as) return;
+    as->sprite.src = ASprite_FrameAt(as, sim_time);
     Sprite_Draw(&as->sprite);
 }
 
-// Libera las animaciones y sus frames.
+// Suelta el clip. No libera nada: los clips son del registro (Clip_FreeAll).
 void ASprite_Free(AnimatedSprite *as)
 {
     if (!as) return;
-    for (int i = 0; i < as->anim_count; i++)
-        Anim_Free(&as->animations[i]);
-    free(as->animations);
-    as->animations = NULL;
-    as->anim_count = 0;
+    as->anim = (AnimState){.clip = -1};
 }
@@ -1,10 +1,10 @@
 /**
  * @file text.c
- * @brief Implementacion del sistema de renderizado de texto con cache de texturas.
+ * @brief Implementacion del sistema de renderizado de texto con atlas de glyphs.
  *
- * Gestiona la carga de fuentes, la creacion de objetos Text y el
- * renderizado eficiente mediante texturas cacheadas que solo se
- * regeneran cuando el contenido cambia.
+ * Las fuentes y sus atlas vienen del servicio de fuentes (font.h); aca se
+ * hace la distribucion de cada texto en quads. Los glyphs se rasterizan en
+ * blanco una sola vez; el color del texto va en los vertices.
  */
 
 // ============================================================
@@ -14,77 +14,154 @@
 #define _POSIX_C_SOURCE 200809L
 #include "text.h"
 #include "engine.h"
+#include "renderqueue.h"
 #include "tools.h"
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 
 // ============================================================
 //  Variables privadas
 // ============================================================
 
-/** @brief Fuente TTF cargada por defecto para todos los objetos Text. */
-static TTF_Font *defaultFont = NULL;
+#define TEXT_MIN_QUADS 16
+
+/** @brief Fuente por defecto para todos los objetos Text (una referencia del servicio). */
+static Font *defaultFont = NULL;
 
 /** @brief Color por defecto (blanco opaco) usado al crear texto sin color explicito. */
 static SDL_Color defaultColor = {255, 255, 255, 255};
 
 // ============================================================
-//  Sistema de texto
+//  Funciones internas (static)
 // ============================================================
 
-/** @brief Inicializa el sistema de texto cargando la fuente por defecto. */
-bool Text_InitSystem(const char *fontPath, int defaultSize)
+/** @brief Decodifica el siguiente codepoint UTF-8 y avanza el puntero (invalido = FONT_FALLBACK). */
+static Uint32 nextCodepoint(const char **str)
 {
-    defaultFont = TTF_OpenFont(fontPath, defaultSize);
-    if (!defaultFont)
-    {
-        printDebug(LOG_ERROR, "No se pudo cargar fuente: %s\n", TTF_GetError());
-        return false;
-    }
-    return true;
-}
+    const unsigned char *s = (const unsigned char *)*str;
+    Uint32 cp;
+    int extra;
 
-/** @brief Cierra el sistema de texto y libera la fuente por defecto. */
-void Text_QuitSystem(void)
-{
-    if (defaultFont)
+    if (s[0] < 0x80)      { cp = s[0];        extra = 0; }
+    else if (s[0] < 0xC0) { *str += 1; return FONT_FALLBACK; }
+    else if (s[0] < 0xE0) { cp = s[0] & 0x1F; extra = 1; }
+    else if (s[0] < 0xF0) { cp = s[0] & 0x0F; extra = 2; }
+    else                  { cp = s[0] & 0x07; extra = 3; }
+
+    int i = 1;
+    for (; i <= extra; i++)
     {
-        TTF_CloseFont(defaultFont);
-        defaultFont = NULL;
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            *str += i;
+            return FONT_FALLBACK;
+        }
+        cp = (cp << 6) | (s[i] & 0x3F);
     }
-    TTF_Quit();
+    *str += i;
+    return cp;
 }
 
-// ============================================================
-//  Funciones internas (static)
-// ============================================================
-
 /**
- * @brief Renderiza el contenido de un Text a una textura SDL.
+ * @brief Distribuye el contenido de un Text en quads sobre el atlas.
  *
- * Destruye la textura previa si existe, genera una nueva superficie
- * con TTF_RenderUTF8_Blended y la convierte en textura. Actualiza
- * las dimensiones del rect del texto.
+ * Dos pasadas por pagina: los quads quedan agrupados por pagina para que
+ * Text_Draw emita una sola llamada por cada una. Soporta saltos de linea
+ * y aplica el kerning de la fuente. Actualiza rect.w y rect.h.
  */
-static void Text_Render(Text *text)
+static void Text_Layout(Text *text)
 {
-    if (text->texture)
+    text->quad_count = 0;
+    memset(text->page_quads, 0, sizeof(text->page_quads));
+    text->rect.w = 0;
+    text->rect.h = 0;
+    text->laid_at = (SDL_Point){text->rect.x, text->rect.y};
+    text->laid_color = text->color;
+
+    const Font *font = text->font;
+    if (!font || !text->content || text->content[0] == '\0')
+        return;
+
+    // Como mucho un quad por byte
+    int needed = (int)strlen(text->content);
+    if (needed > text->capacity)
     {
-        SDL_DestroyTexture(text->texture);
-        text->texture = NULL;
+        int cap = text->capacity > 0 ? text->capacity : TEXT_MIN_QUADS;
+        while (cap < needed)
+            cap *= 2;
+        SDL_Vertex *tmp = realloc(text->vertices, (size_t)cap * 4 * sizeof(SDL_Vertex));
+        if (!tmp)
+        {
+            printDebug(LOG_ERROR, "No se pudo asignar memoria para el texto\n");
+            return;
+        }
+        text->vertices = tmp;
+        text->capacity = cap;
     }
 
-    if (!text->content || text->content[0] == '\0')
-        return;
+    for (int page = 0; page < font->page_count; page++)
+    {
+        int penX = 0, penY = 0, width = 0;
+        Uint32 prev = 0;
+        const char *s = text->content;
+        while (*s)
+        {
+            Uint32 cp = nextCodepoint(&s);
+            if (cp == '\n')
+            {
+                penX = 0;
+                penY += font->line_skip;
+                prev = 0;
+                continue;
+            }
 
-    SDL_Surface *surface = TTF_RenderUTF8_Blended(text->font, text->content, text->color);
-    if (!surface)
-        return;
+            const FontGlyph *g = Font_Glyph(font, &cp);
+            penX += Font_Kerning(font, prev, cp);
+            prev = cp;
+
+            if (g->page == page)
+            {
+                float x0 = (float)(text->rect.x + penX + g->offset_x);
+                float y0 = (float)(text->rect.y + penY);
+                float x1 = x0 + (float)g->src.w;
+                float y1 = y0 + (float)g->src.h;
+                SDL_Vertex *v = &text->vertices[text->quad_count * 4];
+                v[0] = (SDL_Vertex){{x0, y0}, text->color, {g->u0, g->v0}};
+                v[1] = (SDL_Vertex){{x1, y0}, text->color, {g->u1, g->v0}};
+                v[2] = (SDL_Vertex){{x1, y1}, text->color, {g->u1, g->v1}};
+                v[3] = (SDL_Vertex){{x0, y1}, text->color, {g->u0, g->v1}};
+                text->quad_count++;
+                text->page_quads[page]++;
+            }
+
+            penX += g->advance;
+            if (penX > width)
+                width = penX;
+        }
+
+        // Las medidas son las mismas en todas las pasadas
+        text->rect.w = width;
+        text->rect.h = penY + font->height;
+    }
+}
+
+// ============================================================
+//  Sistema de texto
+// ============================================================
+
+/** @brief Inicializa el sistema de texto pidiendo la fuente por defecto al servicio. */
+bool Text_InitSystem(const char *fontPath, int defaultSize)
+{
+    defaultFont = Font_Acquire(fontPath, defaultSize);
+    return defaultFont != NULL;
+}
 
-    text->texture = SDL_CreateTextureFromSurface(render, surface);
-    text->rect.w = surface->w;
-    text->rect.h = surface->h;
-    SDL_FreeSurface(surface);
+/** @brief Cierra el sistema de texto y suelta la fuente por defecto. */
+void Text_QuitSystem(void)
+{
+    Font_Release(defaultFont);
+    defaultFont = NULL;
 }
 
 // ============================================================
@@ -109,13 +186,13 @@ Text Text_CreateColored(const char *content, int x, int y, SDL_Color color)
     if (content)
     {
         text.content = strdup(content);
-        Text_Render(&text);
+        Text_Layout(&text);
     }
 
     return text;
 }
 
-/** @brief Actualiza el contenido del texto, re-renderizando solo si cambia. */
+/** @brief Actualiza el contenido del texto, redistribuyendo solo si cambia. */
 void Text_Set(Text *text, const char *content)
 {
     // Si el contenido es igual, no hacer nada (optimización clave)
@@ -124,22 +201,272 @@ void Text_Set(Text *text, const char *content)
 
     free(text->content);
     text->content = content ? strdup(content) : NULL;
-    Text_Render(text);
+    Text_Layout(text);
 }
 
-/** @brief Dibuja el texto en pantalla usando el renderer global. */
+/** @brief Cambia la fuente del texto y lo redistribuye. */
+void Text_SetFont(Text *text, Font *font)
+{
+    if (text->font == font)
+        return;
+    text->font = font;
+    Text_Layout(text);
+}
+
+/** @brief Dibuja el texto: una llamada por pagina (o al batch abierto). */
 void Text_Draw(Text *text)
 {
-    if (text->texture)
-        SDL_RenderCopy(render, text->texture, NULL, &text->rect);
+    if (text->quad_count <= 0)
+        return;
+
+    const Font *font = text->font;
+
+    // Mover o recolorear el texto no requiere redistribuirlo
+    int dx = text->rect.x - text->laid_at.x;
+    int dy = text->rect.y - text->laid_at.y;
+    bool recolor = memcmp(&text->color, &text->laid_color, sizeof(SDL_Color)) != 0;
+    if (dx || dy || recolor)
+    {
+        for (int i = 0; i < text->quad_count * 4; i++)
+        {
+            text->vertices[i].position.x += (float)dx;
+            text->vertices[i].position.y += (float)dy;
+            text->vertices[i].color = text->color;
+        }
+        text->laid_at = (SDL_Point){text->rect.x, text->rect.y};
+        text->laid_color = text->color;
+    }
+
+    int first = 0;
+    for (int page = 0; page < font->page_count; page++)
+    {
+        int n = text->page_quads[page];
+        if (n > 0)
+            RenderQueue_Quads(font->pages[page], &text->vertices[first * 4], n, RENDER_LAYER_HUD, 0);
+        first += n;
+    }
 }
 
-/** @brief Libera la textura y la cadena de contenido de un objeto Text. */
+/** @brief Libera los vertices y la cadena de contenido de un objeto Text. */
 void Text_Free(Text *text)
 {
-    if (text->texture)
-        SDL_DestroyTexture(text->texture);
+    free(text->vertices);
     free(text->content);
-    text->texture = NULL;
+    text->vertices = NULL;
     text->content = NULL;
+    text->quad_count = 0;
+    text->capacity = 0;
+}
+
+// ============================================================
+//  Texto numerico
+// ============================================================
+
+/** @brief Indice de un caracter en NUMBER_CHARSET (-1 = celda vacia). */
+static int numberGlyphIndex(char c)
+{
+    const char *at = c ? strchr(NUMBER_CHARSET, c) : NULL;
+    return at ? (int)(at - NUMBER_CHARSET) : -1;
+}
+
+/** @brief Mayor valor que entra en 'room' digitos. */
+static unsigned long numberMax(int room)
+{
+    unsigned long max = 0;
+    for (int i = 0; i < room && max < ULONG_MAX / 10; i++)
+        max = max * 10 + 9;
+    return max;
+}
+
+/**
+ * @brief Escribe un entero en 'out' (sin terminador) con el relleno pedido.
+ *
+ * Con ceros el signo va primero ("-0042"); con espacios va pegado al
+ * numero ("  -42").
+ * @return Caracteres escritos.
+ */
+static int formatNumber(char *out, unsigned long value, bool negative, int width, bool zeros)
+{
+    char reversed[NUMBER_MAX_CHARS];
+    int count = 0;
+    do
+    {
+        reversed[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value && count < NUMBER_MAX_CHARS);
+
+    int body = count + (negative ? 1 : 0);
+    int pad = width > body ? width - body : 0;
+    if (body + pad > NUMBER_MAX_CHARS)
+        pad = 0;
+
+    int len = 0;
+    if (negative && zeros)
+        out[len++] = '-';
+    for (int i = 0; i < pad; i++)
+        out[len++] = zeros ? '0' : ' ';
+    if (negative && !zeros)
+        out[len++] = '-';
+    while (count > 0 && len < NUMBER_MAX_CHARS)
+        out[len++] = reversed[--count];
+    return len;
+}
+
+/** @brief Arma los quads de las celdas con los quads ya preparados, agrupados por pagina. */
+static void numberLayout(NumberText *number)
+{
+    number->quad_count = 0;
+    memset(number->page_quads, 0, sizeof(number->page_quads));
+    number->laid_at = number->pos;
+    number->laid_color = number->color;
+    if (!number->font)
+        return;
+
+    float x0 = (float)number->pos.x;
+    if (number->flags & NUMBER_ALIGN_RIGHT)
+        x0 -= (float)(number->length * number->cell_w);
+    float y0 = (float)number->pos.y;
+
+    for (int page = 0; page < number->font->page_count; page++)
+    {
+        for (int i = 0; i < number->length; i++)
+        {
+            int idx = numberGlyphIndex(number->chars[i]);
+            if (idx < 0 || number->glyphs[idx].page != page)
+                continue;
+
+            const NumberGlyph *g = &number->glyphs[idx];
+            float x = x0 + (float)(i * number->cell_w) + g->dst.x;
+            float y = y0 + g->dst.y;
+            SDL_Vertex *v = &number->vertices[number->quad_count * 4];
+            v[0] = (SDL_Vertex){{x, y}, number->color, {g->u0, g->v0}};
+            v[1] = (SDL_Vertex){{x + g->dst.w, y}, number->color, {g->u1, g->v0}};
+            v[2] = (SDL_Vertex){{x + g->dst.w, y + g->dst.h}, number->color, {g->u1, g->v1}};
+            v[3] = (SDL_Vertex){{x, y + g->dst.h}, number->color, {g->u0, g->v1}};
+            number->quad_count++;
+            number->page_quads[page]++;
+        }
+    }
+}
+
+/** @brief Cambia los caracteres mostrados; solo rearma si son distintos. */
+static bool numberApply(NumberText *number, const char *chars, int length)
+{
+    if (length == number->length && memcmp(chars, number->chars, (size_t)length) == 0)
+        return false;
+    memcpy(number->chars, chars, (size_t)length);
+    number->length = length;
+    numberLayout(number);
+    return true;
+}
+
+/** @brief Prepara los quads de NUMBER_CHARSET y el ancho de celda. */
+NumberText NumberText_Create(Font *font, int x, int y, int digits, Uint8 flags)
+{
+    NumberText number = {0};
+    number.pos    = (SDL_Point){x, y};
+    number.color  = defaultColor;
+    number.font   = font ? font : defaultFont;
+    number.digits = SDL_max(0, SDL_min(digits, NUMBER_MAX_CHARS));
+    number.flags  = flags;
+
+    const int count = (int)sizeof(NUMBER_CHARSET) - 1;
+    const FontGlyph *source[sizeof(NUMBER_CHARSET) - 1];
+    for (int i = 0; i < count; i++)
+    {
+        number.glyphs[i].page = -1;
+        if (!number.font)
+            continue;
+        Uint32 cp = (Uint32)(unsigned char)NUMBER_CHARSET[i];
+        source[i] = Font_Glyph(number.font, &cp);
+        if (source[i]->advance > number.cell_w)
+            number.cell_w = source[i]->advance;
+    }
+    if (!number.font)
+        return number;
+    number.h = number.font->height;
+
+    // Cada glyph centrado en su celda
+    for (int i = 0; i < count; i++)
+    {
+        const FontGlyph *fg = source[i];
+        NumberGlyph *g = &number.glyphs[i];
+        if (fg->page < 0)
+            continue;
+        g->page = fg->page;
+        g->dst  = (SDL_FRect){(float)((number.cell_w - fg->advance) / 2 + fg->offset_x), 0.0f,
+                              (float)fg->src.w, (float)fg->src.h};
+        g->u0 = fg->u0;
+        g->v0 = fg->v0;
+        g->u1 = fg->u1;
+        g->v1 = fg->v1;
+    }
+    return number;
+}
+
+/** @brief Muestra un entero saturado al ancho fijo. */
+bool NumberText_Set(NumberText *number, long value)
+{
+    bool negative = value < 0;
+    unsigned long magnitude = negative ? 0UL - (unsigned long)value : (unsigned long)value;
+    if (number->digits == 1 && negative)
+    {
+        // El signo no deja lugar para digitos
+        negative  = false;
+        magnitude = 0;
+    }
+    if (number->digits > 0)
+    {
+        unsigned long max = numberMax(number->digits - (negative ? 1 : 0));
+        if (magnitude > max)
+            magnitude = max;
+    }
+
+    char chars[NUMBER_MAX_CHARS];
+    int length = formatNumber(chars, magnitude, negative, number->digits, number->flags & NUMBER_LEADING_ZEROS);
+    return numberApply(number, chars, length);
+}
+
+/** @brief Muestra un tiempo M:SS saturado al ancho fijo. */
+bool NumberText_SetTime(NumberText *number, int seconds)
+{
+    if (seconds < 0)
+        seconds = 0;
+    int minuteDigits = number->digits > 3 ? number->digits - 3 : 0;
+    unsigned long minutes = (unsigned long)(seconds / 60);
+    int secs = seconds % 60;
+    if (minuteDigits > 0 && minutes > numberMax(minuteDigits))
+    {
+        minutes = numberMax(minuteDigits);
+        secs = 59;
+    }
+
+    char chars[NUMBER_MAX_CHARS];
+    int length = formatNumber(chars, minutes, false, minuteDigits, number->flags & NUMBER_LEADING_ZEROS);
+    if (length + 3 > NUMBER_MAX_CHARS)
+        length = NUMBER_MAX_CHARS - 3;
+    chars[length++] = ':';
+    chars[length++] = (char)('0' + secs / 10);
+    chars[length++] = (char)('0' + secs % 10);
+    return numberApply(number, chars, length);
+}
+
+/** @brief Dibuja el numero: una llamada por pagina (o al batch abierto). */
+void NumberText_Draw(NumberText *number)
+{
+    // Mover o recolorear rearma a lo sumo NUMBER_MAX_CHARS quads
+    if (number->pos.x != number->laid_at.x || number->pos.y != number->laid_at.y ||
+        memcmp(&number->color, &number->laid_color, sizeof(SDL_Color)) != 0)
+        numberLayout(number);
+    if (number->quad_count <= 0)
+        return;
+
+    int first = 0;
+    for (int page = 0; page < number->font->page_count; page++)
+    {
+        int n = number->page_quads[page];
+        if (n > 0)
+            RenderQueue_Quads(number->font->pages[page], &number->vertices[first * 4], n, RENDER_LAYER_HUD, 0);
+        first += n;
+    }
 }
@@ -0,0 +1,297 @@
+/**
+ * @file tilemap.c
+ * @brief Implementacion del mapa de tiles: celdas compactas, horneado de
+ *        chunks en texturas de render y dibujo de los chunks visibles.
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+#include "tilemap.h"
+#include "camera.h"
+#include "engine.h"
+#include "renderqueue.h"
+#include "sprites.h"
+#include "tools.h"
+#include <stdlib.h>
+#include <math.h>
+
+// ============================================================
+// Funciones internas (static)
+// ============================================================
+
+// Rango [*first, *last) de celdas de 'size' pixeles que tocan [from, from + length).
+static void visibleRange(float from, float length, int size, int count, int *first, int *last)
+{
+    *first = (int)floorf(from / (float)size);
+    *last  = (int)ceilf((from + length) / (float)size);
+    if (*first < 0) *first = 0;
+    if (*last > count) *last = count;
+}
+
+// Region del tile dentro de la pagina del tileset (false si esta vacio o fuera de rango).
+static bool tileSource(const Tilemap *map, Uint16 tile, SDL_Rect *src)
+{
+    if (tile == TILEMAP_EMPTY || tile >= map->tileset_count)
+        return false;
+    *src = (SDL_Rect){
+        map->tileset.src.x + (tile % map->tileset_cols) * map->tile_w,
+        map->tileset.src.y + (tile / map->tileset_cols) * map->tile_h,
+        map->tile_w, map->tile_h
+    };
+    return true;
+}
+
+// Dibuja las celdas de un chunk sobre su textura (el target ya esta activo).
+// Retorna false si el chunk quedo vacio.
+static bool bakeChunk(Tilemap *map, int cx, int cy)
+{
+    int index = cy * map->chunks_x + cx;
+    int x0 = cx * map->chunk_cols, y0 = cy * map->chunk_rows;
+    int cols = SDL_min(map->chunk_cols, map->width - x0);
+    int rows = SDL_min(map->chunk_rows, map->height - y0);
+
+    bool empty = true;
+    for (int ty = 0; ty < rows && empty; ty++)
+        for (int tx = 0; tx < cols && empty; tx++)
+            empty = map->tiles[(y0 + ty) * map->width + x0 + tx] == TILEMAP_EMPTY;
+    if (empty)
+    {
+        if (map->chunks[index])
+            SDL_DestroyTexture(map->chunks[index]);
+        map->chunks[index] = NULL;
+        return false;
+    }
+
+    if (!map->chunks[index])
+    {
+        map->chunks[index] = SDL_CreateTexture(render, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                               cols * map->tile_w, rows * map->tile_h);
+        if (!map->chunks[index])
+        {
+            printDebug(LOG_WARN, "No se pudo crear el chunk %d,%d: %s. Se dibuja por tile\n", cx, cy, SDL_GetError());
+            map->baked = false;
+            return false;
+        }
+        SDL_SetTextureBlendMode(map->chunks[index], SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_SetRenderTarget(render, map->chunks[index]);
+    SDL_SetRenderDrawColor(render, 0, 0, 0, 0);
+    SDL_RenderClear(render);
+    for (int ty = 0; ty < rows; ty++)
+    {
+        for (int tx = 0; tx < cols; tx++)
+        {
+            SDL_Rect src;
+            if (!tileSource(map, map->tiles[(y0 + ty) * map->width + x0 + tx], &src))
+                continue;
+            SDL_Rect dst = {tx * map->tile_w, ty * map->tile_h, map->tile_w, map->tile_h};
+            SDL_RenderCopy(render, map->tileset.texture, &src, &dst);
+        }
+    }
+    return true;
+}
+
+// Hornea los chunks sucios de [cx0, cx1) x [cy0, cy1) preservando el estado del renderer.
+static int bakeRange(Tilemap *map, int cx0, int cy0, int cx1, int cy1)
+{
+    int pending = 0;
+    for (int cy = cy0; cy < cy1; cy++)
+        for (int cx = cx0; cx < cx1; cx++)
+            pending += map->dirty[cy * map->chunks_x + cx];
+    if (!pending || !map->baked)
+        return 0;
+
+    SDL_Texture *prevTarget = SDL_GetRenderTarget(render);
+    SDL_Rect prevViewport;
+    float prevSx, prevSy;
+    Uint8 r, g, b, a;
+    SDL_BlendMode prevBlend = SDL_BLENDMODE_BLEND;
+    SDL_RenderGetViewport(render, &prevViewport);
+    SDL_RenderGetScale(render, &prevSx, &prevSy);
+    SDL_GetRenderDrawColor(render, &r, &g, &b, &a);
+    SDL_GetTextureBlendMode(map->tileset.texture, &prevBlend);
+
+    // Copia exacta de los pixeles del tileset (alpha incluido) sobre el chunk
+    SDL_RenderSetScale(render, 1.0f, 1.0f);
+    SDL_SetTextureBlendMode(map->tileset.texture, SDL_BLENDMODE_NONE);
+
+    int baked = 0;
+    for (int cy = cy0; cy < cy1 && map->baked; cy++)
+    {
+        for (int cx = cx0; cx < cx1 && map->baked; cx++)
+        {
+            Uint8 *dirty = &map->dirty[cy * map->chunks_x + cx];
+            if (!*dirty)
+                continue;
+            // Los pixeles del chunk cambian bajo el mismo puntero
+            if (bakeChunk(map, cx, cy))
+                RenderQueue_TextureChanged(map->chunks[cy * map->chunks_x + cx]);
+            *dirty = 0;
+            baked++;
+        }
+    }
+
+    SDL_SetTextureBlendMode(map->tileset.texture, prevBlend);
+    SDL_SetRenderTarget(render, prevTarget);
+    SDL_RenderSetScale(render, prevSx, prevSy);
+    SDL_RenderSetViewport(render, &prevViewport);
+    SDL_SetRenderDrawColor(render, r, g, b, a);
+    return baked;
+}
+
+// ============================================================
+// API
+// ============================================================
+
+bool Tilemap_Create(Tilemap *map, int width, int height, int tileW, int tileH, TextureRegion tileset)
+{
+    *map = (Tilemap){0};
+    if (width <= 0 || height <= 0 || tileW <= 0 || tileH <= 0 || !tileset.texture ||
+        tileset.src.w < tileW || tileset.src.h < tileH)
+    {
+        printDebug(LOG_ERROR, "Tilemap invalido: %dx%d celdas de %dx%d\n", width, height, tileW, tileH);
+        return false;
+    }
+
+    map->width         = width;
+    map->height        = height;
+    map->tile_w        = tileW;
+    map->tile_h        = tileH;
+    map->tileset       = tileset;
+    map->tileset_cols  = tileset.src.w / tileW;
+    map->tileset_count = map->tileset_cols * (tileset.src.h / tileH);
+    map->chunk_cols    = SDL_max(1, TILEMAP_CHUNK_SIZE / tileW);
+    map->chunk_rows    = SDL_max(1, TILEMAP_CHUNK_SIZE / tileH);
+    map->chunks_x      = (width + map->chunk_cols - 1) / map->chunk_cols;
+    map->chunks_y      = (height + map->chunk_rows - 1) / map->chunk_rows;
+    map->baked         = SDL_RenderTargetSupported(render);
+
+    size_t cells = (size_t)width * (size_t)height;
+    size_t chunkCount = (size_t)map->chunks_x * (size_t)map->chunks_y;
+    map->tiles  = malloc(cells * sizeof(Uint16));
+    map->chunks = calloc(chunkCount, sizeof(SDL_Texture *));
+    map->dirty  = calloc(chunkCount, sizeof(Uint8));
+    if (!map->tiles || !map->chunks || !map->dirty)
+    {
+        printDebug(LOG_ERROR, "No se pudo asignar memoria para el tilemap (%dx%d)\n", width, height);
+        Tilemap_Free(map);
+        return false;
+    }
+    for (size_t i = 0; i < cells; i++)
+        map->tiles[i] = TILEMAP_EMPTY;
+    return true;
+}
+
+void Tilemap_Free(Tilemap *map)
+{
+    if (map->chunks)
+    {
+        for (int i = 0; i < map->chunks_x * map->chunks_y; i++)
+            if (map->chunks[i])
+                SDL_DestroyTexture(map->chunks[i]);
+    }
+    free(map->chunks);
+    free(map->dirty);
+    free(map->tiles);
+    *map = (Tilemap){0};
+}
+
+void Tilemap_Set(Tilemap *map, int tx, int ty, Uint16 tile)
+{
+    if (tx < 0 || ty < 0 || tx >= map->width || ty >= map->height)
+        return;
+    Uint16 *cell = &map->tiles[ty * map->width + tx];
+    if (*cell == tile)
+        return;
+    *cell = tile;
+    map->dirty[(ty / map->chunk_rows) * map->chunks_x + tx / map->chunk_cols] = 1;
+}
+
+Uint16 Tilemap_Get(const Tilemap *map, int tx, int ty)
+{
+    if (tx < 0 || ty < 0 || tx >= map->width || ty >= map->height)
+        return TILEMAP_EMPTY;
+    return map->tiles[ty * map->width + tx];
+}
+
+void Tilemap_Invalidate(Tilemap *map)
+{
+    for (int i = 0; i < map->chunks_x * map->chunks_y; i++)
+        map->dirty[i] = 1;
+}
+
+int Tilemap_Bake(Tilemap *map)
+{
+    map->last_bakes = bakeRange(map, 0, 0, map->chunks_x, map->chunks_y);
+    return map->last_bakes;
+}
+
+// Solo se hornean (y dibujan) los chunks que tocan la vista de la camara activa.
+int Tilemap_Draw(Tilemap *map, Uint8 layer)
+{
+    map->last_bakes = 0;
+    if (!map->tiles)
+        return 0;
+    if (!map->baked)
+        return Tilemap_DrawTiles(map, layer);
+
+    SDL_FRect v = Camera_View(NULL);
+    int chunkW = map->chunk_cols * map->tile_w;
+    int chunkH = map->chunk_rows * map->tile_h;
+    int cx0, cx1, cy0, cy1;
+    visibleRange(v.x - map->x, v.w, chunkW, map->chunks_x, &cx0, &cx1);
+    visibleRange(v.y - map->y, v.h, chunkH, map->chunks_y, &cy0, &cy1);
+    if (cx0 >= cx1 || cy0 >= cy1)
+        return 0;
+
+    map->last_bakes = bakeRange(map, cx0, cy0, cx1, cy1);
+    if (!map->baked)
+        return Tilemap_DrawTiles(map, layer);
+
+    int copies = 0;
+    for (int cy = cy0; cy < cy1; cy++)
+    {
+        for (int cx = cx0; cx < cx1; cx++)
+        {
+            SDL_Texture *chunk = map->chunks[cy * map->chunks_x + cx];
+            if (!chunk)
+                continue;
+            int cols = SDL_min(map->chunk_cols, map->width - cx * map->chunk_cols);
+            int rows = SDL_min(map->chunk_rows, map->height - cy * map->chunk_rows);
+            SDL_Rect src = {0, 0, cols * map->tile_w, rows * map->tile_h};
+            Sprite s = Sprite_Create(chunk, src, map->x + (float)(cx * chunkW), map->y + (float)(cy * chunkH));
+            RenderQueue_Sprite(&s, layer, 0);
+            copies++;
+        }
+    }
+    return copies;
+}
+
+int Tilemap_DrawTiles(const Tilemap *map, Uint8 layer)
+{
+    if (!map->tiles)
+        return 0;
+
+    SDL_FRect v = Camera_View(NULL);
+    int tx0, tx1, ty0, ty1;
+    visibleRange(v.x - map->x, v.w, map->tile_w, map->width, &tx0, &tx1);
+    visibleRange(v.y - map->y, v.h, map->tile_h, map->height, &ty0, &ty1);
+
+    int count = 0;
+    for (int ty = ty0; ty < ty1; ty++)
+    {
+        for (int tx = tx0; tx < tx1; tx++)
+        {
+            SDL_Rect src;
+            if (!tileSource(map, map->tiles[ty * map->width + tx], &src))
+                continue;
+            Sprite s = Sprite_Create(map->tileset.texture, src, map->x + (float)(tx * map->tile_w),
+                                     map->y + (float)(ty * map->tile_h));
+            RenderQueue_Sprite(&s, layer, 0);
+            count++;
+        }
+    }
+    return count;
+}
@@ -40,6 +40,30 @@ int recBinarySearch(int arr[], int left, int right, int key)
     return -1;
 }
 
+/** @brief Hash FNV-1a de 64 bits (offset basis y primo del estandar). */
+Uint64 hashString(const char *str)
+{
+    Uint64 hash = HASH_SEED;
+    for (const unsigned char *p = (const unsigned char *)str; p && *p; p++)
+    {
+        hash ^= *p;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/** @brief FNV-1a de 64 bits sobre un bloque, continuando desde 'hash'. */
+Uint64 hashBytes(const void *data, size_t size, Uint64 hash)
+{
+    const unsigned char *p = data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= p[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
 // ============================================================
 // Sistema de archivos
 // ============================================================